@@ -97,9 +97,17 @@ int main(int argc, char const** argv) {
 	try {
 		auto a_in = zenkit::Read::from(positional[0]);
 		auto a_ar = zenkit::ReadArchive::from(a_in.get());
-		auto a = a_ar->read_object(ver_input);
-
 		auto a_out = zenkit::Write::to(positional[1]);
+
+		// Without changing the game version, the archive can be converted without loading it entirely. Binary
+		// archives don't store the types of their entries, so they need to be loaded to be converted.
+		auto binary = a_ar->get_header().format == zenkit::ArchiveFormat::BINARY;
+		if (ver_input == ver_output && (!binary || fmt == zenkit::ArchiveFormat::BINARY)) {
+			a_ar->transcode(a_out.get(), fmt);
+			return 0;
+		}
+
+		auto a = a_ar->read_object(ver_input);
 		auto a_ar_o = zenkit::WriteArchive::to(a_out.get(), fmt);
 		a_ar_o->write_object(a, ver_output);
 	} catch (std::exception const& e) {
@@ -7,7 +7,9 @@
 #include "zenkit/Object.hh"
 #include "zenkit/Stream.hh"
 
+#include <functional>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -91,6 +93,24 @@ namespace zenkit {
 		std::uint32_t index;
 	};
 
+	/// \brief Decides whether an object is loaded by ReadArchive::read_object.
+	///
+	/// <p>The filter is called with the header of the object and its type before the object is constructed. If it
+	/// returns `false`, the object is skipped.</p>
+	using ArchiveObjectFilter = std::function<bool(ArchiveObject const& obj, ObjectType type)>;
+
+	/// \brief The location of an object in a ZenGin archive as recorded by ReadArchive::index_objects.
+	struct ArchiveObjectLocation {
+		/// \brief The offset of the object's header in the archive's stream.
+		std::size_t offset;
+
+		/// \brief The nesting depth of the object relative to the position the index was built from.
+		std::uint32_t depth;
+
+		/// \brief The header of the object.
+		ArchiveObject object;
+	};
+
 	enum class ArchiveEntryType : uint8_t {
 		STRING = 0x1,
 		INTEGER = 0x2,
@@ -119,6 +139,53 @@ namespace zenkit {
 		hash ZKREM("renamed to ArchiveEntryType::HASH") = HASH,
 	};
 
+	/// \brief The kinds of events produced by ReadArchive::read_event.
+	enum class ArchiveEventType : uint8_t {
+		/// \brief The beginning of an object. Its header is available in ArchiveEvent::object.
+		OBJECT_BEGIN = 0,
+
+		/// \brief The end of the object most recently begun.
+		OBJECT_END = 1,
+
+		/// \brief A plain entry. Its type, name and size are available in ArchiveEvent.
+		ENTRY = 2,
+
+		/// \brief The end of the archive.
+		END = 3,
+	};
+
+	/// \brief An event produced by ReadArchive::read_event.
+	///
+	/// <p>Events are meant to be reused between calls to ReadArchive::read_event, so that the strings they hold
+	/// don't need to be allocated again for every event.</p>
+	struct ArchiveEvent {
+		/// \brief The kind of event.
+		ArchiveEventType type {ArchiveEventType::END};
+
+		/// \brief The header of the object begun. Only valid for ArchiveEventType::OBJECT_BEGIN.
+		ArchiveObject object {};
+
+		/// \brief The type of the entry. Only valid for ArchiveEventType::ENTRY.
+		///
+		/// <p>Entries of binary archives are not tagged with their types. Their events span all data of an object
+		/// up to its end and are always reported as ArchiveEntryType::RAW.</p>
+		ArchiveEntryType entry {ArchiveEntryType::RAW};
+
+		/// \brief The name of the entry or an empty string if the archive does not store entry names.
+		///
+		/// <p>Raw entries without a name are data stored directly in the archive's stream. This is the case for
+		/// all entries of binary archives and for the mesh of a world, which follows the `MeshAndBsp` object
+		/// header as its version and size followed by the data. Such entries are best read from the stream
+		/// returned by ReadArchive::get_stream.</p>
+		std::string name {};
+
+		/// \brief The size of the entry's value in bytes.
+		///
+		/// <p>For entries of ASCII archives, this is the length of the value's text, except for raw entries, for
+		/// which it is the number of bytes encoded.</p>
+		std::size_t size {0};
+	};
+
 	/// \brief A reader for ZenGin archives.
 	class ZKAPI ReadArchive {
 	public:
@@ -144,6 +211,16 @@ namespace zenkit {
 
 		std::shared_ptr<Object> read_object(GameVersion version);
 
+		/// \brief Read the next object, unless it is rejected by the given filter.
+		///
+		/// <p>Rejected objects are skipped using ReadArchive::skip_object without being constructed. References are
+		/// always resolved, since they don't construct any objects.</p>
+		///
+		/// \param version The version of the game the archive is from.
+		/// \param filter The filter deciding whether to load the object.
+		/// \return The object read or `nullptr` if it was rejected or could not be read.
+		std::shared_ptr<Object> read_object(GameVersion version, ArchiveObjectFilter const& filter);
+
 		/// \brief Tries to read the begin of a new object from the archive.
 		///
 		/// If a beginning of an object could not be read, the internal buffer is reverted to the state
@@ -222,11 +299,83 @@ namespace zenkit {
 
 		virtual std::unique_ptr<Read> read_raw(std::size_t size) = 0;
 
+		/// \brief Reads all values of a `rawFloat` entry from the reader.
+		/// \return The values read.
+		/// \throws zenkit::ParserError if the value actually present is not a `rawFloat` entry
+		virtual std::vector<float> read_raw_float() = 0;
+
 		/// \brief Skips the next object in the reader and all it's children
 		/// \param skip_current If `false` skips the next object in this buffer, otherwise skip the object
 		///                     currently being read.
 		virtual void skip_object(bool skip_current);
 
+		/// \brief Allocate all objects read from this archive using the given memory resource.
+		///
+		/// <p>Objects are still returned as `std::shared_ptr`s, but they and their control blocks are placed in
+		/// \p resource, which is kept alive until the last of them is destroyed. With a
+		/// `std::pmr::monotonic_buffer_resource`, for example, the objects of a world are allocated in a few large
+		/// blocks which are freed all at once. Strings and containers within objects are allocated separately.</p>
+		///
+		/// <p>Since objects return their memory to \p resource when they are destroyed, it must be safe to use from
+		/// all threads objects might be destroyed on.</p>
+		///
+		/// \param resource The memory resource to allocate objects from or `nullptr` to use the default allocator.
+		void set_memory_resource(std::shared_ptr<std::pmr::memory_resource> resource) noexcept {
+			_m_arena = std::move(resource);
+		}
+
+		/// \brief Read the next event from the archive.
+		///
+		/// <p>This is a pull-based alternative to ReadArchive::read_object, which does not construct any objects. For
+		/// every ArchiveEventType::ENTRY event, the entry's value may be read using the regular `read_*` functions
+		/// before requesting the next event. Entries which are not read are skipped automatically.</p>
+		///
+		/// \param[out] ev The event to store the data in.
+		/// \return `true` if an event was read, `false` if the end of the archive was reached. In this case,
+		///         ArchiveEvent::type is set to ArchiveEventType::END.
+		/// \throws zenkit::ParserError if the archive is malformed.
+		bool read_event(ArchiveEvent& ev);
+
+		/// \brief Convert the rest of this archive into another format without loading any objects.
+		///
+		/// <p>Objects, entries, references and raw data like the mesh of a world are copied one by one, thus
+		/// objects unknown to *ZenKit* are preserved. ASCII archives written by the original engine store bytes
+		/// and words as integers, so those are written as integers when converting from them.</p>
+		///
+		/// <p>Binary archives do not store the types of their entries and can thus only be transcoded into other
+		/// binary archives. Their objects keep their indices, thus the rest of the archive is copied verbatim.</p>
+		///
+		/// \param w The stream to write the new archive to.
+		/// \param format The format of the new archive.
+		/// \throws zenkit::ParserError if the archive is malformed or can't be converted to \p format.
+		void transcode(Write* w, ArchiveFormat format);
+
+		/// \brief Build an index of all objects from the current position to the end of the enclosing object.
+		///
+		/// <p>The archive is scanned once without constructing any objects and the position of the stream is restored
+		/// afterwards. Use ReadArchive::find_object and ReadArchive::seek_object to jump directly to any of the
+		/// objects found, for example to load the way-net of a world without parsing all of its VObs first.</p>
+		///
+		/// <p>Binary archives do not store the types of their entries, thus only objects which can be discovered
+		/// using the size prefixes of their parents are indexed. These are all objects at the current level and
+		/// the children of objects which consist of nothing but other objects.</p>
+		///
+		/// \return The locations of all objects found, ordered by their offset.
+		std::span<ArchiveObjectLocation const> index_objects();
+
+		/// \brief Find an object in the index built by ReadArchive::index_objects.
+		/// \param index The index of the object (see ArchiveObject::index).
+		/// \return The location of the object or `nullptr` if the object was not indexed.
+		[[nodiscard]] ArchiveObjectLocation const* find_object(std::uint32_t index) const noexcept;
+
+		/// \brief Position the reader at the beginning of the given object.
+		///
+		/// <p>The next call to ReadArchive::read_object_begin or ReadArchive::read_object reads the object. Objects
+		/// referenced by it, which have not yet been read, can not be resolved.</p>
+		///
+		/// \param loc The location of the object as returned by ReadArchive::index_objects.
+		virtual void seek_object(ArchiveObjectLocation const& loc);
+
 		/// \return The header of the archive
 		[[nodiscard]] ArchiveHeader const& get_header() const noexcept {
 			return header;
@@ -251,11 +400,46 @@ namespace zenkit {
 		/// \brief Skips the next entry in the reader.
 		virtual void skip_entry() = 0;
 
+		/// \brief Check whether all objects and entries of the archive have been read.
+		/// \return `true` if no more objects or entries follow.
+		[[nodiscard]] virtual bool is_at_end() const noexcept {
+			return read->eof();
+		}
+
+		/// \brief Find all objects from the current position to the end of the enclosing object.
+		/// \param out The list to append the locations of all objects found to.
+		virtual void scan_objects(std::vector<ArchiveObjectLocation>& out);
+
+		/// \brief Read the next event from the archive.
+		///
+		/// <p>Object begins and ends are consumed. For entries, the stream is left at the start of the entry.</p>
+		///
+		/// \param[out] ev The event to store the data in.
+		/// \param[out] end The offset of the end of the entry. Only set for ArchiveEventType::ENTRY.
+		/// \return `false` if the end of the archive was reached.
+		virtual bool next_event(ArchiveEvent& ev, size_t& end) = 0;
+
+		/// \brief Pre-size the table used for resolving references.
+		/// \param count The number of objects in the archive as stated in its header.
+		void reserve_objects(std::size_t count);
+
 		ArchiveHeader header;
 		Read* read;
 
 	private:
-		std::unordered_map<uint32_t, std::shared_ptr<Object>> _m_cache {};
+		void cache_object(uint32_t index, std::shared_ptr<Object> const& obj);
+		[[nodiscard]] std::shared_ptr<Object> find_cached_object(uint32_t index) const;
+
+		/// \brief Objects read so far by their index. Since object indices are dense, a flat table is used
+		///        except for indices which are way out of range.
+		std::vector<std::shared_ptr<Object>> _m_cache {};
+		std::unordered_map<uint32_t, std::shared_ptr<Object>> _m_cache_sparse {};
+		std::shared_ptr<std::pmr::memory_resource> _m_arena {};
+		std::vector<ArchiveObjectLocation> _m_index {};
+		std::unordered_map<uint32_t, size_t> _m_index_lookup {};
+		size_t _m_event_entry {SIZE_MAX};
+		size_t _m_event_entry_end {0};
+		size_t _m_event_mesh {SIZE_MAX};
 		std::unique_ptr<Read> _m_owned;
 	};
 
@@ -300,7 +484,12 @@ namespace zenkit {
 		[[nodiscard]] virtual Write* get_stream() const noexcept = 0;
 
 	private:
-		std::unordered_map<Object const*, uint32_t> _m_cache {};
+		[[nodiscard]] uint32_t const* find_cached_object(Object const* obj) const noexcept;
+		void cache_object(Object const* obj, uint32_t index);
+
+		/// \brief The indices of all objects written so far as an open-addressing hash table.
+		std::vector<std::pair<Object const*, uint32_t>> _m_cache {};
+		std::size_t _m_cache_count {0};
 		bool _m_save {false};
 	};
 } // namespace zenkit
@@ -1,13 +1,54 @@
 // Copyright © 2023 GothicKit Contributors.
 // SPDX-License-Identifier: MIT
 #pragma once
+#include <cstdint>
 #include <filesystem>
 
 namespace zenkit {
+	/// \brief Access pattern hints for memory-mapped files.
+	///
+	/// Hints may be combined using `|`. They are purely advisory: hints which are not supported by
+	/// the host platform are silently ignored or replaced by the closest available alternative, and
+	/// a failure to apply a hint never causes the mapping itself to fail. If ZenKit is built without
+	/// memory-mapping support, all hints are ignored.
+	enum class MmapHint : std::uint8_t {
+		NONE = 0,
+
+		/// \brief The mapping will be read front to back (e.g. archives and VDF catalogs).
+		///        Enables aggressive read-ahead. Takes precedence over #RANDOM.
+		SEQUENTIAL = 1,
+
+		/// \brief The mapping will be accessed at random offsets (e.g. VDF payloads). Disables read-ahead.
+		RANDOM = 2,
+
+		/// \brief Start reading the mapping in the background right away.
+		WILL_NEED = 4,
+
+		/// \brief Pre-fault the entire mapping before returning. Falls back to #WILL_NEED
+		///        where pre-faulting is not supported.
+		POPULATE = 8,
+
+		/// \brief Back the mapping with transparent huge pages, if the host supports it for file mappings.
+		HUGE_PAGES = 16,
+	};
+
+	[[nodiscard]] constexpr bool operator&(MmapHint a, MmapHint b) noexcept {
+		return (static_cast<std::uint8_t>(a) & static_cast<std::uint8_t>(b)) != 0;
+	}
+
+	[[nodiscard]] constexpr MmapHint operator|(MmapHint a, MmapHint b) noexcept {
+		return static_cast<MmapHint>(static_cast<std::uint8_t>(a) | static_cast<std::uint8_t>(b));
+	}
+
+	constexpr MmapHint& operator|=(MmapHint& a, MmapHint b) noexcept {
+		a = a | b;
+		return a;
+	}
+
 #ifdef _ZK_WITH_MMAP
 	class Mmap {
 	public:
-		explicit Mmap(std::filesystem::path const& path);
+		explicit Mmap(std::filesystem::path const& path, MmapHint hints = MmapHint::NONE);
 
 		Mmap(Mmap const&) = delete;
 		Mmap(Mmap&&) noexcept;
@@ -23,8 +64,8 @@ namespace zenkit {
 		}
 
 	private:
-		std::byte const* _m_data;
-		std::size_t _m_size;
+		std::byte const* _m_data {nullptr};
+		std::size_t _m_size {0};
 
 		void* _m_platform_handle {nullptr};
 	};
@@ -14,6 +14,7 @@
 
 namespace zenkit {
 	class World;
+	struct WorldLoadOptions;
 	class Read;
 
 	/// \brief Contains general information about a save-game.
@@ -136,6 +137,13 @@ namespace zenkit {
 		[[nodiscard]] ZKAPI std::shared_ptr<World> load_world() const;
 		[[nodiscard]] ZKAPI std::shared_ptr<World> load_world(std::string_view name) const;
 
+		/// \brief Load only parts of a world stored in the save-game.
+		/// \param name The name of the world's file, i.e. `NEWWORLD.ZEN`.
+		/// \param options The parts of the world to load.
+		/// \return The world loaded or `nullptr` if the save-game does not contain the world.
+		[[nodiscard]] ZKAPI std::shared_ptr<World> load_world(std::string_view name,
+		                                                      WorldLoadOptions const& options) const;
+
 		SaveMetadata metadata {};
 		SaveState state {};
 		std::optional<Texture> thumbnail {};
@@ -4,11 +4,18 @@
 #include "zenkit/Library.hh"
 #include "zenkit/Logger.hh"
 #include "zenkit/Misc.hh"
+#include "zenkit/Mmap.hh"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace zenkit {
@@ -20,6 +27,88 @@ namespace zenkit {
 
 	enum class Whence { BEG = 0x00, CUR = 0x01, END = 0x02 };
 
+	/// \brief A non-virtual cursor over a contiguous, read-only memory buffer.
+	///
+	/// <p>All memory-backed Read instances, like the ones returned by Read::from(std::byte const*, size_t),
+	/// Read::from(std::filesystem::path const&) or VfsNode::open_read, are backed by a ReadCursor which may be
+	/// obtained by calling Read::cursor. Primitive reads performed through Read are automatically routed through the
+	/// cursor if one is available, which avoids a virtual call for every value read.</p>
+	///
+	/// <p>The cursor never owns the buffer it points into. Seeking outside of the buffer is ignored and reading past
+	/// its end yields zero-initialized values, just like it does for all other Read implementations.</p>
+	class ReadCursor {
+	public:
+		constexpr ReadCursor() noexcept = default;
+		constexpr ReadCursor(std::byte const* bytes, size_t len) noexcept
+		    : _m_begin(bytes), _m_end(bytes + len), _m_position(bytes) {}
+
+		template <typename T>
+		    requires std::is_trivially_copyable_v<T>
+		[[nodiscard]] T read() noexcept {
+			T v {};
+
+			if (static_cast<size_t>(_m_end - _m_position) >= sizeof v) [[likely]] {
+				std::memcpy(&v, _m_position, sizeof v);
+				_m_position += sizeof v;
+			} else {
+				this->read(&v, sizeof v);
+			}
+
+			return v;
+		}
+
+		size_t read(void* buf, size_t len) noexcept {
+			len = std::min(len, this->remaining());
+			if (len == 0) return 0;
+
+			std::memcpy(buf, _m_position, len);
+			_m_position += len;
+			return len;
+		}
+
+		void seek(ssize_t off, Whence whence) noexcept {
+			auto base = whence == Whence::BEG ? 0 : static_cast<ssize_t>(whence == Whence::CUR ? tell() : size());
+			auto position = static_cast<size_t>(base + off);
+
+			// Note: This also catches negative positions since they wrap around.
+			if (position > this->size()) return;
+			_m_position = _m_begin + position;
+		}
+
+		[[nodiscard]] size_t tell() const noexcept {
+			return static_cast<size_t>(_m_position - _m_begin);
+		}
+
+		[[nodiscard]] bool eof() const noexcept {
+			return _m_position >= _m_end;
+		}
+
+		/// \return The total size of the underlying buffer in bytes.
+		[[nodiscard]] size_t size() const noexcept {
+			return static_cast<size_t>(_m_end - _m_begin);
+		}
+
+		/// \return The number of bytes left to read.
+		[[nodiscard]] size_t remaining() const noexcept {
+			return static_cast<size_t>(_m_end - _m_position);
+		}
+
+		/// \return A pointer to the start of the underlying buffer.
+		[[nodiscard]] std::byte const* data() const noexcept {
+			return _m_begin;
+		}
+
+		/// \return A pointer to the byte at the current position in the underlying buffer.
+		[[nodiscard]] std::byte const* current() const noexcept {
+			return _m_position;
+		}
+
+	private:
+		std::byte const* _m_begin {nullptr};
+		std::byte const* _m_end {nullptr};
+		std::byte const* _m_position {nullptr};
+	};
+
 	/// \brief Basic input device abstraction for <i>ZenKit</i>.
 	///
 	/// <p>Provides functions for reading primitives from an underlying datasource in little-endian. May be subclassed
@@ -66,14 +155,17 @@ namespace zenkit {
 	///   <tr>
 	///     <td>Read::from(std::filesystem::path const&)</td>
 	///     <td>Memory-maps the file at the given path and creates a Read instance from it. The memory mapping is held
-	///     until the instance is destroyed.</td>
+	///     until the instance is destroyed. Optionally accepts MmapHint flags describing the expected access
+	///     pattern, e.g. MmapHint::SEQUENTIAL for archives.</td>
 	///   </tr>
 	/// </tbody>
 	/// </table>
 	///
 	/// <h3>Implementing a custom Read</h3>
 	/// <p>Implementing a custom Read is as simple as creating a new subclass and implementing the Read::read,
-	/// Read::seek, Read::tell and Read::eof member functions.</p>
+	/// Read::seek, Read::tell and Read::eof member functions. Subclasses backed by contiguous memory may additionally
+	/// pass a ReadCursor to the constructor to enable the fast path for primitive reads. The virtual member functions
+	/// of such subclasses must then operate on that same cursor.</p>
 	class ZKAPI Read {
 	public:
 		virtual ~Read() noexcept = default;
@@ -95,6 +187,42 @@ namespace zenkit {
 
 		[[nodiscard]] virtual std::string read_line_then_ignore(std::string_view chars) noexcept;
 
+		/// \brief Read a string of the given length without copying it, if possible.
+		///
+		/// <p>For memory-backed streams (see Read::cursor), the returned view points directly into the underlying
+		/// buffer and stays valid for as long as that buffer does. For all other streams, the string is copied into an
+		/// internal buffer which is overwritten by the next call to any of the `*_view` functions.</p>
+		///
+		/// \param len The number of bytes to read.
+		/// \return A view of the string read.
+		/// \see Read::read_string
+		[[nodiscard]] std::string_view read_string_view(size_t len) noexcept;
+
+		/// \brief Read a line without copying it, if possible.
+		///
+		/// <p>Behaves exactly like Read::read_line, except that a view is returned. See Read::read_string_view for
+		/// details about the lifetime of the returned view.</p>
+		///
+		/// \param skipws Whether to skip whitespace after the end of the line.
+		/// \return A view of the line read, excluding the line terminator.
+		/// \see Read::read_line
+		[[nodiscard]] std::string_view read_line_view(bool skipws) noexcept;
+
+		/// \brief Read a contiguous array of values in a single operation.
+		///
+		/// <p>The values are copied from the underlying data source verbatim, thus the in-memory layout of \p T must
+		/// match its on-disk layout exactly. Elements which could not be read because the end of the stream was
+		/// reached are zero-initialized.</p>
+		///
+		/// \param v The values to read into.
+		template <typename T>
+		    requires std::is_trivially_copyable_v<T>
+		void read_array(std::span<T> v) noexcept {
+			auto* dst = reinterpret_cast<std::byte*>(v.data());
+			auto len = this->read_raw(dst, v.size_bytes());
+			if (len < v.size_bytes()) std::memset(dst + len, 0, v.size_bytes() - len);
+		}
+
 		virtual size_t read(void* buf, size_t len) noexcept = 0;
 		virtual void seek(ssize_t off, Whence whence) noexcept = 0;
 		[[nodiscard]] virtual size_t tell() const noexcept = 0;
@@ -105,9 +233,88 @@ namespace zenkit {
 		[[nodiscard]] static std::unique_ptr<Read> from(std::byte const* bytes, size_t len);
 		[[nodiscard]] static std::unique_ptr<Read> from(std::vector<std::byte> const* vector);
 		[[nodiscard]] static std::unique_ptr<Read> from(std::vector<std::byte> vector);
-		[[nodiscard]] static std::unique_ptr<Read> from(std::filesystem::path const& path);
+		[[nodiscard]] static std::unique_ptr<Read> from(std::filesystem::path const& path,
+		                                                MmapHint hints = MmapHint::NONE);
+
+		/// \brief Get the cursor of memory-backed streams.
+		/// \return The cursor backing this stream or `nullptr` if the stream is not backed by contiguous memory.
+		[[nodiscard]] ReadCursor* cursor() const noexcept {
+			return _m_cursor;
+		}
+
+	protected:
+		Read() noexcept = default;
+		explicit Read(ReadCursor* cursor) noexcept : _m_cursor(cursor) {}
+
+		Read(Read const&) = delete;
+		Read& operator=(Read const&) = delete;
+
+	private:
+		size_t read_raw(void* buf, size_t len) noexcept {
+			if (_m_cursor != nullptr) [[likely]] {
+				return _m_cursor->read(buf, len);
+			}
+
+			return this->read(buf, len);
+		}
+
+		template <typename T>
+		[[nodiscard]] T read_any() noexcept {
+			if (_m_cursor != nullptr) [[likely]] {
+				return _m_cursor->read<T>();
+			}
+
+			T v {};
+			this->read(&v, sizeof v);
+			return v;
+		}
+
+		ReadCursor* _m_cursor {nullptr};
+		std::string _m_view_buffer;
 	};
 
+	inline char Read::read_char() noexcept {
+		return this->read_any<char>();
+	}
+
+	inline int8_t Read::read_byte() noexcept {
+		return this->read_any<int8_t>();
+	}
+
+	inline uint8_t Read::read_ubyte() noexcept {
+		return this->read_any<uint8_t>();
+	}
+
+	inline int16_t Read::read_short() noexcept {
+		return this->read_any<int16_t>();
+	}
+
+	inline uint16_t Read::read_ushort() noexcept {
+		return this->read_any<uint16_t>();
+	}
+
+	inline int32_t Read::read_int() noexcept {
+		return this->read_any<int32_t>();
+	}
+
+	inline uint32_t Read::read_uint() noexcept {
+		return this->read_any<uint32_t>();
+	}
+
+	inline float Read::read_float() noexcept {
+		return this->read_any<float>();
+	}
+
+	inline Vec2 Read::read_vec2() noexcept {
+		static_assert(sizeof(Vec2) == 2 * sizeof(float));
+		return this->read_any<Vec2>();
+	}
+
+	inline Vec3 Read::read_vec3() noexcept {
+		static_assert(sizeof(Vec3) == 3 * sizeof(float));
+		return this->read_any<Vec3>();
+	}
+
 	class Write ZKAPI {
 	public:
 		virtual ~Write() noexcept = default;
@@ -128,15 +335,68 @@ namespace zenkit {
 		void write_mat3(Mat3 const& v) noexcept;
 		void write_mat4(Mat4 const& v) noexcept;
 
+		/// \brief Write a contiguous array of values in a single operation.
+		///
+		/// <p>The values are written verbatim, thus the in-memory layout of \p T must match its on-disk layout
+		/// exactly, including the absence of padding.</p>
+		///
+		/// \param v The values to write.
+		template <typename T>
+		    requires std::is_trivially_copyable_v<T>
+		void write_array(std::span<T const> v) noexcept {
+			this->write(v.data(), v.size_bytes());
+		}
+
+		/// \brief Reserve a slot of the given size for a value which is only known later.
+		///
+		/// <p>The slot is filled with zeroes and can be filled in by calling Write::write_at with the returned
+		/// offset once its value is known. This is the preferred way of back-patching sizes and offsets since
+		/// it allows buffered and memory-backed implementations to avoid seeking the underlying data sink.</p>
+		///
+		/// \param len The size of the slot in bytes.
+		/// \return The offset of the reserved slot.
+		[[nodiscard]] size_t reserve(size_t len) noexcept;
+
+		/// \brief Fill a slot previously reserved using Write::reserve.
+		/// \param off The offset of the slot as returned by Write::reserve.
+		/// \param v The value to write into the slot.
+		void write_uint_at(size_t off, uint32_t v) noexcept;
+
+		/// \brief Overwrite already written data at the given offset without moving the write position.
+		///
+		/// <p>The default implementation seeks to the given offset, writes the data and then seeks back. Subclasses
+		/// should override this function if they can patch the data in a cheaper way.</p>
+		///
+		/// \param off The offset to write the data at.
+		/// \param buf The data to write.
+		/// \param len The number of bytes to write.
+		virtual void write_at(size_t off, void const* buf, size_t len) noexcept;
+
+		/// \brief Write any buffered data to the underlying data sink.
+		virtual void flush() noexcept {}
+
 		virtual size_t write(void const* buf, size_t len) noexcept = 0;
 		virtual void seek(ssize_t off, Whence whence) noexcept = 0;
 		[[nodiscard]] virtual size_t tell() const noexcept = 0;
 
+		/// \brief Open the file at the given path for writing.
+		/// \note The returned stream is buffered, see Write::buffered.
 		[[nodiscard]] static std::unique_ptr<Write> to(std::filesystem::path const& path);
 		[[nodiscard]] static std::unique_ptr<Write> to(FILE* stream);
 		[[nodiscard]] static std::unique_ptr<Write> to(std::ostream* stream);
 		[[nodiscard]] static std::unique_ptr<Write> to(std::byte* bytes, size_t len);
 		[[nodiscard]] static std::unique_ptr<Write> to(std::vector<std::byte>* vector);
+
+		/// \brief Wrap the given stream in a buffer.
+		///
+		/// <p>All data is collected in a buffer of the given capacity and only written to the sink when the buffer
+		/// is full, when seeking outside of the buffer or when the buffered stream is flushed or destroyed. Slots
+		/// filled by Write::write_at are patched in the buffer if they have not been written to the sink yet.</p>
+		///
+		/// \param sink The stream to write to. Must outlive the returned stream.
+		/// \param capacity The capacity of the buffer in bytes.
+		/// \return The buffered stream.
+		[[nodiscard]] static std::unique_ptr<Write> buffered(Write* sink, size_t capacity = 1024 * 1024);
 	};
 
 	namespace proto {
@@ -212,16 +472,12 @@ namespace zenkit {
 		    requires std::is_enum_v<T>
 		void write_chunk(Write* w, T v, std::function<void(Write*)> const& cb) {
 			w->write_ushort(static_cast<uint16_t>(v));
-
-			auto size_off = static_cast<ssize_t>(w->tell());
-			w->write_uint(0);
+			auto size_off = w->reserve(sizeof(uint32_t));
 
 			cb(w);
 
-			auto len = static_cast<ssize_t>(w->tell()) - size_off - static_cast<ssize_t>(sizeof(uint32_t));
-			w->seek(size_off, Whence::BEG);
-			w->write_uint(static_cast<uint32_t>(len));
-			w->seek(len, Whence::CUR);
+			auto len = w->tell() - size_off - sizeof(uint32_t);
+			w->write_uint_at(size_off, static_cast<uint32_t>(len));
 		}
 	} // namespace proto
 } // namespace zenkit
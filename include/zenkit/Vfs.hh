@@ -7,11 +7,15 @@
 #include "Mmap.hh"
 #include "Stream.hh"
 
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -36,7 +40,10 @@ namespace zenkit {
 		FILE = 2,
 	};
 
+	class VfsHostFile;
+
 	struct VfsFileDescriptor {
+		/// \brief The contents of the file or `nullptr` if the file is mapped on demand.
 		std::byte const* memory;
 		std::size_t size;
 
@@ -45,10 +52,21 @@ namespace zenkit {
 		~VfsFileDescriptor() noexcept;
 
 	private:
-		size_t* refcnt;
+		friend class Vfs;
+		friend class VfsNode;
+
+		ZKINT VfsFileDescriptor(VfsHostFile* host, size_t len);
+
+		std::atomic<size_t>* refcnt;
+		VfsHostFile* host {nullptr};
 	};
 
 	class VfsNode;
+	class VfsIndex;
+	class VfsHostFiles;
+	class VfsNodeTable;
+	struct VfsDiskCatalog;
+	struct VfsCompactDisk;
 
 	struct VfsNodeComparator {
 		using is_transparent = std::true_type;
@@ -62,6 +80,15 @@ namespace zenkit {
 		using ChildContainer = std::set<VfsNode, VfsNodeComparator>;
 
 	public:
+		/// \brief Copy a node. The copy is detached from any Vfs the original node belongs to.
+		ZKAPI VfsNode(VfsNode const& cpy);
+
+		/// \brief Move a node. The node and its descendants are detached from any Vfs they belong to.
+		ZKAPI VfsNode(VfsNode&& other) noexcept;
+
+		ZKAPI VfsNode& operator=(VfsNode const& cpy);
+		ZKAPI VfsNode& operator=(VfsNode&& other) noexcept;
+
 		[[nodiscard]] ZKAPI VfsNodeType type() const noexcept;
 		[[nodiscard]] ZKAPI std::time_t time() const noexcept;
 		[[nodiscard]] ZKAPI std::string const& name() const noexcept;
@@ -86,9 +113,25 @@ namespace zenkit {
 		ZKAPI explicit VfsNode(std::string_view name, VfsFileDescriptor dev, std::time_t ts);
 
 	private:
+		friend class Vfs;
+		friend class VfsIndex;
+		friend class VfsOverlay;
+
 		std::string _m_name;
 		std::time_t _m_time;
 		std::variant<ChildContainer, VfsFileDescriptor> _m_data;
+
+		/// \brief The hash of the normalized path of this node, if it is part of a Vfs.
+		std::uint64_t _m_path_hash {0};
+
+		/// \brief The index of the Vfs this node belongs to or `nullptr` if it is detached.
+		VfsIndex* _m_index {nullptr};
+
+		/// \brief The directory containing this node, if it is part of a Vfs.
+		VfsNode* _m_parent {nullptr};
+
+		/// \brief The position of this node in the extension index of the Vfs it belongs to.
+		std::size_t _m_extension_slot {0};
 	};
 
 	enum class VfsOverwriteBehavior {
@@ -99,10 +142,22 @@ namespace zenkit {
 	};
 
 	/// \brief An implementation of the virtual file system.
+	///
+	/// All `const` member functions of the Vfs and of its nodes, including VfsNode::open_read, may be called
+	/// concurrently from multiple threads, as long as no thread modifies the Vfs at the same time. To keep
+	/// reading while the Vfs is being modified, use #snapshot.
+	///
+	/// Disk files which don't need to be modified after loading them can be loaded into a VfsCompact instead,
+	/// which is faster to load and uses much less memory.
+	///
 	/// \see https://zk.gothickit.dev/library/api/virtual-file-system/
 	class Vfs {
 	public:
 		ZKAPI Vfs();
+		ZKAPI Vfs(Vfs&&) noexcept;
+		ZKAPI ~Vfs() noexcept;
+
+		ZKAPI Vfs& operator=(Vfs&&) noexcept;
 
 		/// \brief Get the root node of the file system structure.
 		/// \return The root node of the file system structure.
@@ -140,10 +195,49 @@ namespace zenkit {
 		///
 		/// \param host The path of the disk to mount.
 		/// \param overwrite The behavior of the system when conflicting files are found.
+		/// \param hints Access pattern hints for the memory mapping of the disk. Since file contents are
+		///              usually read at random offsets, MmapHint::RANDOM is a good choice for most disks.
 		/// \throws VfsBrokenDiskError if the disk file is corrupted or invalid and thus, can't be loaded.
 		/// \see #mount_disk(buffer, VfsOverwriteBehavior)
 		ZKAPI void mount_disk(std::filesystem::path const& host,
-		                      VfsOverwriteBehavior overwrite = VfsOverwriteBehavior::OLDER);
+		                      VfsOverwriteBehavior overwrite = VfsOverwriteBehavior::OLDER,
+		                      MmapHint hints = MmapHint::NONE);
+
+		/// \brief Mount multiple disk files at the given host paths into the file system.
+		///
+		/// The disks are mapped and their catalogs are decoded concurrently. They are then merged into
+		/// the file system one after the other, so the result is identical to calling
+		/// #mount_disk(std::filesystem::path const&, VfsOverwriteBehavior, MmapHint) for each disk in
+		/// the given order. If a disk can't be loaded, all disks before it remain mounted.
+		///
+		/// \param hosts The paths of the disks to mount, in mounting order.
+		/// \param overwrite The behavior of the system when conflicting files are found.
+		/// \param hints Access pattern hints for the memory mappings of the disks.
+		/// \throws VfsBrokenDiskError if a disk file is corrupted or invalid and thus, can't be loaded.
+		ZKAPI void mount_disks(std::span<std::filesystem::path const> hosts,
+		                       VfsOverwriteBehavior overwrite = VfsOverwriteBehavior::OLDER,
+		                       MmapHint hints = MmapHint::NONE);
+
+		/// \brief Mount multiple disk files using a persistent cache of the merged file system.
+		///
+		/// If the file at \p cache was created for the same disks (identified by their path, size and
+		/// modification time) and the same \p overwrite behavior, the merged file system structure is
+		/// loaded from it directly and the disk catalogs are not parsed at all. Otherwise the disks are
+		/// mounted using #mount_disks(std::span<std::filesystem::path const>, VfsOverwriteBehavior, MmapHint)
+		/// and the cache file is (re-)created.
+		///
+		/// The cache is only used if the file system is empty, since it stores the result of mounting
+		/// the disks into an empty file system. A cache file which can't be written is not an error.
+		///
+		/// \param hosts The paths of the disks to mount, in mounting order.
+		/// \param cache The path of the cache file.
+		/// \param overwrite The behavior of the system when conflicting files are found.
+		/// \param hints Access pattern hints for the memory mappings of the disks.
+		/// \throws VfsBrokenDiskError if the cache is stale and a disk file is corrupted or invalid.
+		ZKAPI void mount_disks(std::span<std::filesystem::path const> hosts,
+		                       std::filesystem::path const& cache,
+		                       VfsOverwriteBehavior overwrite = VfsOverwriteBehavior::OLDER,
+		                       MmapHint hints = MmapHint::NONE);
 
 		/// \brief Mount the disk file in the given buffer into the file system.
 		///
@@ -156,6 +250,11 @@ namespace zenkit {
 		ZKAPI void mount_disk(Read* buf, VfsOverwriteBehavior overwrite = VfsOverwriteBehavior::OLDER);
 
 		/// \brief Mount a file or directory from the host file system into the Vfs.
+		///
+		/// Host files are not opened while mounting. Instead, they are mapped into memory when they are first
+		/// opened using VfsNode::open_read. Only the most recently used mappings are kept open, see
+		/// #set_host_file_limit.
+		///
 		/// \note If a path to a directory is provided, only its children are mounted, not the directory itself.
 		/// \param host The path of the file or directory to mount.
 		/// \param parent The path of the parent node to mount into.
@@ -166,7 +265,22 @@ namespace zenkit {
 		                      std::string_view parent,
 		                      VfsOverwriteBehavior overwrite = VfsOverwriteBehavior::ALL);
 
+		/// \brief Set the maximum number of host files kept mapped after they have been read.
+		///
+		/// Files mounted using #mount_host are mapped into memory on demand and cached so that subsequent reads
+		/// don't have to map them again. Once more than \p limit files are cached, the least recently opened ones
+		/// are unmapped. Files which are still being read by an open Read instance stay mapped until the
+		/// Read instance is destroyed. The default limit is 256.
+		///
+		/// \param limit The maximum number of cached host file mappings.
+		ZKAPI void set_host_file_limit(std::size_t limit);
+
 		/// \brief Resolve the given path in the Vfs to a file system node.
+		///
+		/// Paths are matched case-insensitively, empty path components are ignored and trailing
+		/// whitespace is removed from every component. Lookups are served by a hash index over all
+		/// paths in the Vfs, which is kept up to date as nodes are created and removed.
+		///
 		/// \param path The path to the node to resolve.
 		/// \return The node at the given path or `nullptr` if the path could not be resolved.
 		[[nodiscard]] ZKAPI VfsNode const* resolve(std::string_view path) const noexcept;
@@ -177,8 +291,15 @@ namespace zenkit {
 		[[nodiscard]] ZKAPI VfsNode* resolve(std::string_view path) noexcept;
 
 		/// \brief Find the first node with the given name in the Vfs.
+		///
+		/// Names are matched case-insensitively using an index of all node names in the Vfs. If multiple
+		/// nodes share the same name, the one found first by a depth-first search starting at the root
+		/// is returned, which visits the children of a directory before descending into its subdirectories
+		/// in reverse name order.
+		///
 		/// \param name The name of the node to find.
 		/// \return The node with the given name or `nullptr` if no node with the given name was found.
+		/// \see #find_all
 		[[nodiscard]] ZKAPI VfsNode const* find(std::string_view name) const noexcept;
 
 		/// \brief Find the first node with the given name in the Vfs.
@@ -186,16 +307,308 @@ namespace zenkit {
 		/// \return The node with the given name or `nullptr` if no node with the given name was found.
 		[[nodiscard]] ZKAPI VfsNode* find(std::string_view name) noexcept;
 
-		ZKAPI void save(Write* w, GameVersion version, time_t unix_t = 0) const;
+		/// \brief Find all nodes with the given name in the Vfs.
+		/// \param name The name of the nodes to find.
+		/// \return All nodes with the given name, ordered so that the first element is the node returned by #find.
+		[[nodiscard]] ZKAPI std::vector<VfsNode const*> find_all(std::string_view name) const;
+
+		/// \brief Find all nodes with the given name in the Vfs.
+		/// \param name The name of the nodes to find.
+		/// \return All nodes with the given name, ordered so that the first element is the node returned by #find.
+		[[nodiscard]] ZKAPI std::vector<VfsNode*> find_all(std::string_view name);
+
+		/// \brief Get all files with the given extension.
+		///
+		/// Extensions are matched case-insensitively and may be given with or without a leading dot, so `TEX`,
+		/// `.tex` and `*.TEX` are all equivalent. The files are taken from an index of all file extensions in
+		/// the Vfs, which is kept up to date as nodes are created and removed.
+		///
+		/// \param extension The extension of the files to get.
+		/// \return All files with the given extension in no particular order. The returned span is invalidated
+		///         when the Vfs is modified.
+		[[nodiscard]] ZKAPI std::span<VfsNode const* const> with_extension(std::string_view extension) const;
+
+		/// \brief Find all nodes matching the given glob pattern.
+		///
+		/// The pattern is a path whose components may contain the wildcards `*`, matching any number of
+		/// characters, and `?`, matching exactly one character. A component consisting of only `**` matches any
+		/// number of directories, or, if it is the last component, all nodes below its parent. All components
+		/// are matched case-insensitively. The leading components without wildcards are resolved using the path
+		/// index and patterns of the form `[dir/]**/*.EXT` are served by the extension index.
+		///
+		/// \param pattern The glob pattern to match, i.e. `_WORK/DATA/ANIMS/_COMPILED/*` or `**/*.MAN`.
+		/// \return All nodes matching the pattern, in the order of a depth-first traversal of the tree which visits
+		///         the children of each directory in name order.
+		[[nodiscard]] ZKAPI std::vector<VfsNode const*> glob(std::string_view pattern) const;
+
+		/// \brief Get an identifier of the contents of the given file.
+		///
+		/// The identifier is the XXH64 hash of the file's contents, so files with identical contents have the
+		/// same identifier, regardless of their path or the disk they were loaded from. This allows caches of
+		/// decoded assets to be keyed by content rather than by path. Since the hash is not cryptographic,
+		/// different contents may, in rare cases, have the same identifier.
+		///
+		/// Identifiers are computed on first use and cached. Use #index_contents to compute them for all files
+		/// in parallel ahead of time.
+		///
+		/// \param node The file to get the content identifier of.
+		/// \return The content identifier of the file.
+		/// \throws std::bad_variant_access if the given node is a directory.
+		[[nodiscard]] ZKAPI std::uint64_t content_id(VfsNode const& node) const;
+
+		/// \brief Compute the content identifiers of all files in the Vfs in parallel.
+		/// \see #content_id
+		ZKAPI void index_contents() const;
+
+		/// \brief Write the contents of the Vfs as a disk file.
+		///
+		/// The catalog is laid out before any file contents are written, so the disk is written front to back
+		/// without seeking. File contents are written straight from their backing memory and read in from the
+		/// host file system by background threads while the disk is being written.
+		///
+		/// \param w The writer to write the disk to.
+		/// \param version The game version to write the disk for.
+		/// \param unix_t The timestamp to store in the disk or `0` to use the current time.
+		/// \param alignment The alignment of all file contents in the disk, relative to its start. Aligning
+		///                  file contents to the page size allows mapping them directly.
+		/// \param deduplicate Whether to store files with identical contents only once. All catalog entries of
+		///                    such files then refer to the same data.
+		/// \throws Error if the disk would exceed 4 GiB, which is the maximum size of a disk, or if a host file
+		///               changed its size since it was mounted.
+		ZKAPI void save(Write* w,
+		                GameVersion version,
+		                time_t unix_t = 0,
+		                std::uint32_t alignment = 1,
+		                bool deduplicate = false) const;
+
+		/// \brief Create an immutable copy of the current state of the Vfs.
+		///
+		/// The snapshot shares all file contents with this Vfs but has its own copy of the node tree, so this
+		/// Vfs can be modified further (i.e. by mounting more disks) while other threads read from the snapshot.
+		/// Both stay valid independently of each other; the file contents are released once neither of them
+		/// refers to them anymore.
+		///
+		/// \return A snapshot of the Vfs.
+		[[nodiscard]] ZKAPI std::shared_ptr<Vfs const> snapshot() const;
 
 	private:
+		friend class VfsOverlay;
+
 		ZKINT void mount_disk(std::byte const* buf, std::size_t size, VfsOverwriteBehavior overwrite);
+		ZKINT void mount_catalog(VfsNode* parent,
+		                         VfsDiskCatalog const& catalog,
+		                         std::size_t& i,
+		                         VfsOverwriteBehavior overwrite);
+		ZKINT bool load_mount_cache(Read* r, std::span<std::pair<std::byte const*, std::size_t> const> disks);
+		ZKINT bool save_mount_cache(Write* w, std::span<std::pair<std::byte const*, std::size_t> const> disks) const;
+
+		std::unique_ptr<VfsIndex> _m_index;
+		std::unique_ptr<VfsNode> _m_root;
+		std::shared_ptr<VfsHostFiles> _m_host_files;
+		std::vector<std::shared_ptr<std::byte[]>> _m_data;
+
+#ifdef _ZK_WITH_MMAP
+		std::vector<std::shared_ptr<Mmap>> _m_data_mapped;
+#endif
+	};
+
+	/// \brief A node of a VfsCompact.
+	///
+	/// Nodes offer the read-only part of the VfsNode API. They are owned by their VfsCompact and stay valid
+	/// until it is destroyed.
+	class VfsCompactNode {
+	public:
+		[[nodiscard]] ZKAPI VfsNodeType type() const noexcept;
+		[[nodiscard]] ZKAPI std::time_t time() const noexcept;
+
+		/// \return The name of the node. It refers to the catalog of the disk the node was loaded from.
+		[[nodiscard]] ZKAPI std::string_view name() const noexcept;
+
+		/// \return The children of the directory, sorted by name, or an empty span if the node is a file.
+		[[nodiscard]] ZKAPI std::span<VfsCompactNode const> children() const noexcept;
+
+		/// \brief Find the child with the given name, ignoring case and trailing whitespace.
+		/// \param name The name of the child to find.
+		/// \return The child or `nullptr` if it does not exist or this node is a file.
+		[[nodiscard]] ZKAPI VfsCompactNode const* child(std::string_view name) const noexcept;
+
+		/// \throws std::bad_variant_access if the node is a directory.
+		[[nodiscard]] ZKAPI std::unique_ptr<Read> open_read() const;
+
+	private:
+		friend class VfsCompact;
+
+		char const* _m_name;
 
-		VfsNode _m_root;
-		std::vector<std::unique_ptr<std::byte[]>> _m_data;
+		/// \brief The first child of a directory or the contents of a file.
+		union {
+			VfsCompactNode const* _m_children;
+			std::byte const* _m_memory;
+		};
+
+		std::time_t _m_time;
+
+		/// \brief The number of children of a directory or the size of a file.
+		std::uint32_t _m_size;
+		std::uint8_t _m_name_size;
+		bool _m_directory;
+	};
+
+	/// \brief A compact, read-only virtual file system loaded from disk files.
+	///
+	/// <p>A Vfs keeps every node in its own allocation, in a tree of `std::set`s, along with indices of all paths,
+	/// names and extensions so that it can be modified efficiently. This file system is built once from disk files
+	/// instead. All of its nodes are stored in a single array in which the children of each directory form a
+	/// contiguous range, sorted by name. Names are not copied but refer to the catalogs of the disks, which are
+	/// kept in memory for the file contents anyway. This makes loading faster and the file system a fraction of
+	/// the size of an equivalent Vfs, at the cost of resolving paths using a binary search per component.</p>
+	///
+	/// <p>All member functions may be called concurrently from multiple threads.</p>
+	class VfsCompact {
+	public:
+		/// \brief Create an empty file system which only contains the root directory.
+		ZKAPI VfsCompact();
+		ZKAPI VfsCompact(VfsCompact&&) noexcept;
+		ZKAPI ~VfsCompact() noexcept;
+
+		ZKAPI VfsCompact& operator=(VfsCompact&&) noexcept;
+
+		/// \brief Load multiple disk files into a new file system.
+		///
+		/// The result is identical to mounting the disks into an empty Vfs in the given order using
+		/// Vfs::mount_disk(std::filesystem::path const&, VfsOverwriteBehavior, MmapHint).
+		///
+		/// \param hosts The paths of the disks to load, in mounting order.
+		/// \param overwrite The behavior of the system when conflicting files are found.
+		/// \param hints Access pattern hints for the memory mappings of the disks.
+		/// \return The file system containing the contents of all disks.
+		/// \throws VfsBrokenDiskError if a disk file is corrupted or invalid and thus, can't be loaded.
+		[[nodiscard]] ZKAPI static VfsCompact from_disks(std::span<std::filesystem::path const> hosts,
+		                                                 VfsOverwriteBehavior overwrite = VfsOverwriteBehavior::OLDER,
+		                                                 MmapHint hints = MmapHint::NONE);
+
+		/// \brief Get the root node of the file system structure.
+		[[nodiscard]] ZKAPI VfsCompactNode const& root() const noexcept;
+
+		/// \brief Resolve the given path to a file system node.
+		///
+		/// Paths are interpreted just like by Vfs::resolve.
+		///
+		/// \param path The path to the node to resolve.
+		/// \return The node at the given path or `nullptr` if the path could not be resolved.
+		[[nodiscard]] ZKAPI VfsCompactNode const* resolve(std::string_view path) const noexcept;
+
+	private:
+		ZKINT void build(std::span<VfsCompactDisk const> disks, VfsOverwriteBehavior overwrite);
+
+		std::vector<VfsCompactNode> _m_nodes;
+		std::vector<std::shared_ptr<std::byte[]>> _m_data;
 
 #ifdef _ZK_WITH_MMAP
-		std::vector<Mmap> _m_data_mapped;
+		std::vector<std::shared_ptr<Mmap>> _m_data_mapped;
 #endif
 	};
+
+	/// \brief A virtual file system made up of a stack of immutable layers.
+	///
+	/// Unlike Vfs::mount, which merges new nodes into a single tree and thereby destroys the nodes they replace,
+	/// an overlay keeps every layer intact and resolves paths through all of them. A path resolves to the node
+	/// of the layer with the highest priority which contains it. If multiple layers with the same priority
+	/// contain the path, the one pushed last wins. Like with VfsOverwriteBehavior::ALL, a file hides all nodes
+	/// below its path in layers with lower precedence.
+	///
+	/// Layers are indexed by their full paths, so pushing or popping a layer takes time proportional to the
+	/// number of nodes in that layer only, which makes it cheap to toggle mods on and off.
+	///
+	/// All `const` member functions may be called concurrently, as long as no layers are pushed or popped
+	/// at the same time.
+	class VfsOverlay {
+	public:
+		ZKAPI VfsOverlay();
+		ZKAPI VfsOverlay(VfsOverlay&&) noexcept;
+		ZKAPI ~VfsOverlay() noexcept;
+
+		ZKAPI VfsOverlay& operator=(VfsOverlay&&) noexcept;
+
+		/// \brief Add a layer to the overlay.
+		/// \warning The layer must not be modified while it is part of the overlay. Use Vfs::snapshot to obtain
+		///          an immutable copy of a Vfs which is still being modified.
+		/// \param layer The file system to add as a layer.
+		/// \param priority The priority of the layer. Layers with higher priority hide the nodes of layers
+		///                 with lower priority.
+		/// \return An identifier of the layer which can be passed to #pop.
+		ZKAPI std::size_t push(std::shared_ptr<Vfs const> layer, int priority = 0);
+
+		/// \brief Add the disk file at the given host path as a layer.
+		/// \param host The path of the disk to add.
+		/// \param priority The priority of the layer.
+		/// \param hints Access pattern hints for the memory mapping of the disk.
+		/// \return An identifier of the layer which can be passed to #pop.
+		/// \throws VfsBrokenDiskError if the disk file is corrupted or invalid and thus, can't be loaded.
+		/// \see Vfs::mount_disk
+		ZKAPI std::size_t
+		push_disk(std::filesystem::path const& host, int priority = 0, MmapHint hints = MmapHint::NONE);
+
+		/// \brief Add a file or directory from the host file system as a layer.
+		/// \param host The path of the file or directory to add.
+		/// \param priority The priority of the layer.
+		/// \return An identifier of the layer which can be passed to #pop.
+		/// \see Vfs::mount_host
+		ZKAPI std::size_t push_host(std::filesystem::path const& host, int priority = 0);
+
+		/// \brief Remove a layer from the overlay.
+		/// \param layer The identifier of the layer as returned by #push.
+		/// \return `true` if the layer was removed and `false` if there is no such layer.
+		ZKAPI bool pop(std::size_t layer);
+
+		/// \brief Resolve the given path to the node visible in the overlay.
+		///
+		/// Paths are interpreted just like by Vfs::resolve. An empty path resolves to the root of the
+		/// layer with the highest precedence. Use #list to get the merged contents of a directory.
+		///
+		/// \param path The path to the node to resolve.
+		/// \return The node at the given path or `nullptr` if the path could not be resolved.
+		[[nodiscard]] ZKAPI VfsNode const* resolve(std::string_view path) const noexcept;
+
+		/// \brief Find a visible node with the given name.
+		///
+		/// The layers are searched in order of descending precedence, each using Vfs::find_all. The first
+		/// node found which is not hidden by another layer is returned.
+		///
+		/// \param name The name of the node to find.
+		/// \return The node with the given name or `nullptr` if no visible node with the given name was found.
+		[[nodiscard]] ZKAPI VfsNode const* find(std::string_view name) const noexcept;
+
+		/// \brief List the merged contents of the directory at the given path.
+		/// \param path The path of the directory to list.
+		/// \return All visible children of the directory, sorted by name, or an empty list if the path
+		///         does not resolve to a directory.
+		[[nodiscard]] ZKAPI std::vector<VfsNode const*> list(std::string_view path) const;
+
+	private:
+		struct Layer {
+			std::size_t id;
+			int priority;
+			std::shared_ptr<Vfs const> vfs;
+		};
+
+		[[nodiscard]] ZKINT VfsNode const* visible(std::uint64_t hash, std::string_view path) const noexcept;
+		[[nodiscard]] ZKINT VfsNode const* visible(std::uint64_t hash, VfsNode const* at) const noexcept;
+
+		/// \brief Find the node of the layer with the highest precedence among the nodes accepted by \p matches.
+		template <typename F>
+		[[nodiscard]] VfsNode const* find_visible(std::uint64_t hash, F matches) const noexcept;
+		[[nodiscard]] ZKINT bool is_visible(VfsNode const* node) const noexcept;
+		ZKINT void update_ranks();
+
+		/// \brief All layers, ordered by ascending precedence.
+		std::vector<Layer> _m_layers;
+
+		/// \brief The position of each layer in #_m_layers, keyed by the index of its Vfs.
+		std::unordered_map<VfsIndex const*, std::size_t> _m_ranks;
+
+		/// \brief The nodes of all layers, keyed by the hash of their full path.
+		std::unique_ptr<VfsNodeTable> _m_paths;
+		std::size_t _m_next_id {0};
+	};
 } // namespace zenkit
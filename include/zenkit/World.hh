@@ -10,6 +10,7 @@
 #include "zenkit/world/WayNet.hh"
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 namespace zenkit {
@@ -62,6 +63,32 @@ namespace zenkit {
 		float timer;
 	};
 
+	/// \brief Options for loading only parts of a world.
+	///
+	/// <p>Parts which are not loaded are skipped using ReadArchive::skip_object and are never constructed.</p>
+	struct WorldLoadOptions {
+		/// \brief Whether to load the mesh and BSP-tree of the world.
+		bool mesh = true;
+
+		/// \brief Whether to load the VOb tree of the world.
+		bool vobs = true;
+
+		/// \brief Whether to load the way-net of the world.
+		bool way_net = true;
+
+		/// \brief Whether to load the NPCs and NPC spawns of save-games.
+		bool npcs = true;
+
+		/// \brief Decides which VObs of the VOb tree to load. If not set, all VObs are loaded.
+		VobFilter vob_filter {};
+
+		/// \brief The memory resource to allocate the world's objects from (see ReadArchive::set_memory_resource).
+		///
+		/// <p>Only the objects themselves and their control blocks are placed in the arena. Strings, vectors and
+		/// other members of the objects, as well as the mesh of the world, are still allocated on the heap.</p>
+		std::shared_ptr<std::pmr::memory_resource> arena {};
+	};
+
 	/// \brief Represents a ZenGin world.
 	class World : public Object {
 		ZK_OBJECT(ObjectType::oCWorld);
@@ -70,6 +97,18 @@ namespace zenkit {
 		ZKAPI void load(Read* r, GameVersion version);
 
 		ZKAPI void load(ReadArchive& r, GameVersion version) override;
+
+		/// \brief Load only the parts of a world selected by the given options.
+		/// \param r The stream to read the world's archive from.
+		/// \param version The version of the game the world is from.
+		/// \param options The parts of the world to load.
+		ZKAPI void load(Read* r, GameVersion version, WorldLoadOptions const& options);
+
+		/// \brief Load only the parts of a world selected by the given options.
+		/// \param r The archive to read from, positioned after the world's object header.
+		/// \param version The version of the game the world is from.
+		/// \param options The parts of the world to load.
+		ZKAPI void load(ReadArchive& r, GameVersion version, WorldLoadOptions const& options);
 		ZKAPI void save(WriteArchive& w, GameVersion version) const override;
 		[[nodiscard]] ZKAPI uint16_t get_version_identifier(GameVersion game) const override;
 
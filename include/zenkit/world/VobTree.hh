@@ -5,13 +5,45 @@
 #include "zenkit/Misc.hh"
 #include "zenkit/vobs/VirtualObject.hh"
 
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace zenkit {
+	/// \brief Decides how a VOb is handled by parse_vob_tree.
+	enum class VobFilterAction : std::uint8_t {
+		/// \brief Load the VOb and continue with its children.
+		LOAD = 0,
+
+		/// \brief Skip the VOb but continue with its children. Children which are loaded are attached to the
+		///        closest ancestor which is loaded.
+		SKIP = 1,
+
+		/// \brief Skip the VOb and all of its children.
+		SKIP_TREE = 2,
+	};
+
+	/// \brief Decides which VObs are loaded by parse_vob_tree.
+	///
+	/// <p>The filter is called with the header of each VOb and its type before the VOb is constructed. Skipped
+	/// VObs are never constructed.</p>
+	using VobFilter = std::function<VobFilterAction(ArchiveObject const& obj, ObjectType type)>;
+
 	/// \brief Parses a VOB tree from the given reader.
 	/// \param in The reader to read from.
 	/// \param version The version of Gothic being used.
 	/// \return The tree parsed.
 	ZKAPI std::shared_ptr<VirtualObject> parse_vob_tree(ReadArchive& in, GameVersion version);
+
+	/// \brief Parses a VOB tree from the given reader, loading only the VObs accepted by the given filter.
+	/// \param in The reader to read from.
+	/// \param version The version of Gothic being used.
+	/// \param filter The filter deciding which VObs to load or `nullptr` to load all VObs.
+	/// \param out The list to append the loaded VObs without a loaded ancestor to.
+	ZKAPI void parse_vob_tree(ReadArchive& in,
+	                          GameVersion version,
+	                          VobFilter const& filter,
+	                          std::vector<std::shared_ptr<VirtualObject>>& out);
 	ZKAPI void save_vob_tree(WriteArchive& w, GameVersion version, std::shared_ptr<VirtualObject> const& obj);
 } // namespace zenkit
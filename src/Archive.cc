@@ -23,6 +23,7 @@
 #include "zenkit/SaveGame.hh"
 #include "zenkit/World.hh"
 
+#include <algorithm>
 #include <iostream>
 
 namespace zenkit {
@@ -181,7 +182,7 @@ namespace zenkit {
 
 	void ArchiveHeader::load(Read* r) {
 		try {
-			if (r->read_line(true) != "ZenGin Archive") {
+			if (r->read_line_view(true) != "ZenGin Archive") {
 				ZKLOGE("ReadArchive", "Invalid Header");
 				throw ParserError {"ReadArchive", "magic missing"};
 			}
@@ -198,7 +199,7 @@ namespace zenkit {
 
 			this->archiver = r->read_line(true);
 
-			if (auto fmt = r->read_line(true); fmt == "ASCII") {
+			if (auto fmt = r->read_line_view(true); fmt == "ASCII") {
 				this->format = ArchiveFormat::ASCII;
 			} else if (fmt == "BINARY") {
 				this->format = ArchiveFormat::BINARY;
@@ -252,7 +253,58 @@ namespace zenkit {
 		return reader;
 	}
 
+	/// \brief The number of objects the reference table of ReadArchive is sized for at most up front.
+	static constexpr std::size_t MAX_DENSE_OBJECTS = 1 << 20;
+
+	/// \brief Object indices below this are always stored in the flat reference table of ReadArchive.
+	static constexpr std::size_t MIN_DENSE_OBJECTS = 1024;
+
+	/// \brief An allocator which keeps the memory resource it allocates from alive.
+	///
+	/// Used with `std::allocate_shared`, the control block of each object holds a copy of the allocator, so the
+	/// memory resource lives exactly as long as the last object allocated from it.
+	template <typename T>
+	class ArenaAllocator {
+	public:
+		using value_type = T;
+
+		explicit ArenaAllocator(std::shared_ptr<std::pmr::memory_resource> resource) noexcept
+		    : _m_resource(std::move(resource)) {}
+
+		template <typename U>
+		ArenaAllocator(ArenaAllocator<U> const& other) noexcept : _m_resource(other._m_resource) {}
+
+		T* allocate(size_t n) {
+			return static_cast<T*>(_m_resource->allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* p, size_t n) {
+			_m_resource->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		template <typename U>
+		bool operator==(ArenaAllocator<U> const& other) const noexcept {
+			return _m_resource == other._m_resource;
+		}
+
+	private:
+		template <typename U>
+		friend class ArenaAllocator;
+
+		std::shared_ptr<std::pmr::memory_resource> _m_resource;
+	};
+
+	template <typename T>
+	static std::shared_ptr<T> make_object(std::shared_ptr<std::pmr::memory_resource> const& arena) {
+		if (arena == nullptr) return std::make_shared<T>();
+		return std::allocate_shared<T>(ArenaAllocator<T> {arena});
+	}
+
 	std::shared_ptr<Object> ReadArchive::read_object(GameVersion version) {
+		return this->read_object(version, nullptr);
+	}
+
+	std::shared_ptr<Object> ReadArchive::read_object(GameVersion version, ArchiveObjectFilter const& filter) {
 		ArchiveObject obj;
 		if (!this->read_object_begin(obj)) {
 			ZKLOGE("ReadArchive", "Expected object, got entry.");
@@ -265,13 +317,12 @@ namespace zenkit {
 				this->skip_object(true);
 			}
 
-			auto cached = _m_cache.find(obj.index);
-			if (cached == _m_cache.end()) {
+			auto cached = this->find_cached_object(obj.index);
+			if (cached == nullptr) {
 				ZKLOGW("ReadArchive", "Unresolved reference: %d", obj.index);
-				return nullptr;
 			}
 
-			return cached->second;
+			return cached;
 		}
 
 		if (obj.class_name == "%") {
@@ -286,220 +337,225 @@ namespace zenkit {
 			type = it->second;
 		}
 
+		if (filter && !filter(obj, type)) {
+			this->skip_object(true);
+			return nullptr;
+		}
+
 		std::shared_ptr<Object> syn;
 		switch (type) {
 		case ObjectType::oCNpcTalent:
-			syn = std::make_shared<VNpc::Talent>();
+			syn = make_object<VNpc::Talent>(_m_arena);
 			break;
 		case ObjectType::zCEventManager:
-			syn = std::make_shared<EventManager>();
+			syn = make_object<EventManager>(_m_arena);
 			break;
 		case ObjectType::zCDecal:
-			syn = std::make_shared<VisualDecal>();
+			syn = make_object<VisualDecal>(_m_arena);
 			break;
 		case ObjectType::zCMesh:
-			syn = std::make_shared<VisualMesh>();
+			syn = make_object<VisualMesh>(_m_arena);
 			break;
 		case ObjectType::zCProgMeshProto:
-			syn = std::make_shared<VisualMultiResolutionMesh>();
+			syn = make_object<VisualMultiResolutionMesh>(_m_arena);
 			break;
 		case ObjectType::zCParticleFX:
-			syn = std::make_shared<VisualParticleEffect>();
+			syn = make_object<VisualParticleEffect>(_m_arena);
 			break;
 		case ObjectType::zCAICamera:
-			syn = std::make_shared<VisualCamera>();
+			syn = make_object<VisualCamera>(_m_arena);
 			break;
 		case ObjectType::zCModel:
-			syn = std::make_shared<VisualModel>();
+			syn = make_object<VisualModel>(_m_arena);
 			break;
 		case ObjectType::zCMorphMesh:
-			syn = std::make_shared<VisualMorphMesh>();
+			syn = make_object<VisualMorphMesh>(_m_arena);
 			break;
 		case ObjectType::oCAIHuman:
-			syn = std::make_shared<AiHuman>();
+			syn = make_object<AiHuman>(_m_arena);
 			break;
 		case ObjectType::oCAIVobMove:
-			syn = std::make_shared<AiMove>();
+			syn = make_object<AiMove>(_m_arena);
 			break;
 		case ObjectType::zCSkyControler_Outdoor:
-			syn = std::make_shared<SkyController>();
+			syn = make_object<SkyController>(_m_arena);
 			break;
 		case ObjectType::oCCSPlayer:
-			syn = std::make_shared<CutscenePlayer>();
+			syn = make_object<CutscenePlayer>(_m_arena);
 			break;
 		case ObjectType::zCVobLevelCompo:
-			syn = std::make_shared<VLevel>();
+			syn = make_object<VLevel>(_m_arena);
 			break;
 		case ObjectType::zCVobStartpoint:
-			syn = std::make_shared<VStartPoint>();
+			syn = make_object<VStartPoint>(_m_arena);
 			break;
 		case ObjectType::zCVobStair:
-			syn = std::make_shared<VStair>();
+			syn = make_object<VStair>(_m_arena);
 			break;
 		case ObjectType::zCVobSpot:
-			syn = std::make_shared<VSpot>();
+			syn = make_object<VSpot>(_m_arena);
 			break;
 		case ObjectType::zCVob:
-			syn = std::make_shared<VirtualObject>();
+			syn = make_object<VirtualObject>(_m_arena);
 			break;
 		case ObjectType::zCVobScreenFX:
-			syn = std::make_shared<VScreenEffect>();
+			syn = make_object<VScreenEffect>(_m_arena);
 			break;
 		case ObjectType::zCCSCamera:
-			syn = std::make_shared<VCutsceneCamera>();
+			syn = make_object<VCutsceneCamera>(_m_arena);
 			break;
 		case ObjectType::zCCamTrj_KeyFrame:
-			syn = std::make_shared<VCameraTrajectoryFrame>();
+			syn = make_object<VCameraTrajectoryFrame>(_m_arena);
 			break;
 		case ObjectType::zCVobAnimate:
-			syn = std::make_shared<VAnimate>();
+			syn = make_object<VAnimate>(_m_arena);
 			break;
 		case ObjectType::zCZoneVobFarPlane:
-			syn = std::make_shared<VZoneFarPlane>();
+			syn = make_object<VZoneFarPlane>(_m_arena);
 			break;
 		case ObjectType::zCZoneVobFarPlaneDefault:
-			syn = std::make_shared<VZoneFarPlaneDefault>();
+			syn = make_object<VZoneFarPlaneDefault>(_m_arena);
 			break;
 		case ObjectType::zCZoneZFogDefault:
-			syn = std::make_shared<VZoneFogDefault>();
+			syn = make_object<VZoneFogDefault>(_m_arena);
 			break;
 		case ObjectType::zCZoneZFog:
-			syn = std::make_shared<VZoneFog>();
+			syn = make_object<VZoneFog>(_m_arena);
 			break;
 		case ObjectType::zCVobLensFlare:
-			syn = std::make_shared<VLensFlare>();
+			syn = make_object<VLensFlare>(_m_arena);
 			break;
 		case ObjectType::oCItem:
-			syn = std::make_shared<VItem>();
+			syn = make_object<VItem>(_m_arena);
 			break;
 		case ObjectType::zCTrigger:
-			syn = std::make_shared<VTrigger>();
+			syn = make_object<VTrigger>(_m_arena);
 			break;
 		case ObjectType::oCCSTrigger:
-			syn = std::make_shared<VCutsceneTrigger>();
+			syn = make_object<VCutsceneTrigger>(_m_arena);
 			break;
 		case ObjectType::oCMOB:
-			syn = std::make_shared<VMovableObject>();
+			syn = make_object<VMovableObject>(_m_arena);
 			break;
 		case ObjectType::oCMobInter:
-			syn = std::make_shared<VInteractiveObject>();
+			syn = make_object<VInteractiveObject>(_m_arena);
 			break;
 		case ObjectType::oCMobLadder:
-			syn = std::make_shared<VLadder>();
+			syn = make_object<VLadder>(_m_arena);
 			break;
 		case ObjectType::oCMobSwitch:
-			syn = std::make_shared<VSwitch>();
+			syn = make_object<VSwitch>(_m_arena);
 			break;
 		case ObjectType::oCMobWheel:
-			syn = std::make_shared<VWheel>();
+			syn = make_object<VWheel>(_m_arena);
 			break;
 		case ObjectType::oCMobBed:
-			syn = std::make_shared<VBed>();
+			syn = make_object<VBed>(_m_arena);
 			break;
 		case ObjectType::oCMobFire:
-			syn = std::make_shared<VFire>();
+			syn = make_object<VFire>(_m_arena);
 			break;
 		case ObjectType::oCMobContainer:
-			syn = std::make_shared<VContainer>();
+			syn = make_object<VContainer>(_m_arena);
 			break;
 		case ObjectType::oCMobDoor:
-			syn = std::make_shared<VDoor>();
+			syn = make_object<VDoor>(_m_arena);
 			break;
 		case ObjectType::zCPFXController:
-			syn = std::make_shared<VParticleEffectController>();
+			syn = make_object<VParticleEffectController>(_m_arena);
 			break;
 		case ObjectType::zCVobLight:
-			syn = std::make_shared<VLight>();
+			syn = make_object<VLight>(_m_arena);
 			break;
 		case ObjectType::zCVobSound:
-			syn = std::make_shared<VSound>();
+			syn = make_object<VSound>(_m_arena);
 			break;
 		case ObjectType::zCVobSoundDaytime:
-			syn = std::make_shared<VSoundDaytime>();
+			syn = make_object<VSoundDaytime>(_m_arena);
 			break;
 		case ObjectType::oCZoneMusic:
-			syn = std::make_shared<VZoneMusic>();
+			syn = make_object<VZoneMusic>(_m_arena);
 			break;
 		case ObjectType::oCZoneMusicDefault:
-			syn = std::make_shared<VZoneMusicDefault>();
+			syn = make_object<VZoneMusicDefault>(_m_arena);
 			break;
 		case ObjectType::zCMessageFilter:
-			syn = std::make_shared<VMessageFilter>();
+			syn = make_object<VMessageFilter>(_m_arena);
 			break;
 		case ObjectType::zCCodeMaster:
-			syn = std::make_shared<VCodeMaster>();
+			syn = make_object<VCodeMaster>(_m_arena);
 			break;
 		case ObjectType::zCTriggerList:
-			syn = std::make_shared<VTriggerList>();
+			syn = make_object<VTriggerList>(_m_arena);
 			break;
 		case ObjectType::oCTriggerScript:
-			syn = std::make_shared<VTriggerScript>();
+			syn = make_object<VTriggerScript>(_m_arena);
 			break;
 		case ObjectType::zCMover:
-			syn = std::make_shared<VMover>();
+			syn = make_object<VMover>(_m_arena);
 			break;
 		case ObjectType::oCTriggerChangeLevel:
-			syn = std::make_shared<VTriggerChangeLevel>();
+			syn = make_object<VTriggerChangeLevel>(_m_arena);
 			break;
 		case ObjectType::zCTriggerWorldStart:
-			syn = std::make_shared<VTriggerWorldStart>();
+			syn = make_object<VTriggerWorldStart>(_m_arena);
 			break;
 		case ObjectType::oCTouchDamage:
-			syn = std::make_shared<VTouchDamage>();
+			syn = make_object<VTouchDamage>(_m_arena);
 			break;
 		case ObjectType::zCTriggerUntouch:
-			syn = std::make_shared<VTriggerUntouch>();
+			syn = make_object<VTriggerUntouch>(_m_arena);
 			break;
 		case ObjectType::zCEarthquake:
-			syn = std::make_shared<VEarthquake>();
+			syn = make_object<VEarthquake>(_m_arena);
 			break;
 		case ObjectType::zCMoverController:
-			syn = std::make_shared<VMoverController>();
+			syn = make_object<VMoverController>(_m_arena);
 			break;
 		case ObjectType::oCNpc:
-			syn = std::make_shared<VNpc>();
+			syn = make_object<VNpc>(_m_arena);
 			break;
 		case ObjectType::oCWorld:
-			syn = std::make_shared<World>();
+			syn = make_object<World>(_m_arena);
 			break;
 		case ObjectType::zCMaterial:
-			syn = std::make_shared<Material>();
+			syn = make_object<Material>(_m_arena);
 			break;
 		case ObjectType::oCSavegameInfo:
-			syn = std::make_shared<SaveMetadata>();
+			syn = make_object<SaveMetadata>(_m_arena);
 			break;
 		case ObjectType::oCCSManager:
-			syn = std::make_shared<CutsceneManager>();
+			syn = make_object<CutsceneManager>(_m_arena);
 			break;
 		case ObjectType::zCCSPoolItem:
-			syn = std::make_shared<CutscenePoolItem>();
+			syn = make_object<CutscenePoolItem>(_m_arena);
 			break;
 		case ObjectType::zCCutscene:
-			syn = std::make_shared<Cutscene>();
+			syn = make_object<Cutscene>(_m_arena);
 			break;
 		case ObjectType::zCCSCutsceneContext:
-			syn = std::make_shared<CutsceneContext>();
+			syn = make_object<CutsceneContext>(_m_arena);
 			break;
 		case ObjectType::zCCSBlock:
-			syn = std::make_shared<CutsceneBlock>();
+			syn = make_object<CutsceneBlock>(_m_arena);
 			break;
 		case ObjectType::zCCSAtomicBlock:
-			syn = std::make_shared<CutsceneAtomicBlock>();
+			syn = make_object<CutsceneAtomicBlock>(_m_arena);
 			break;
 		case ObjectType::zCCSLib:
-			syn = std::make_shared<CutsceneLibrary>();
+			syn = make_object<CutsceneLibrary>(_m_arena);
 			break;
 		case ObjectType::oCMsgConversation:
-			syn = std::make_shared<ConversationMessageEvent>();
+			syn = make_object<ConversationMessageEvent>(_m_arena);
 			break;
 		case ObjectType::zCCSProps:
-			syn = std::make_shared<CutsceneProps>();
+			syn = make_object<CutsceneProps>(_m_arena);
 			break;
 		case ObjectType::zCWayNet:
-			syn = std::make_shared<WayNet>();
+			syn = make_object<WayNet>(_m_arena);
 			break;
 		case ObjectType::zCWaypoint:
-			syn = std::make_shared<WayPoint>();
+			syn = make_object<WayPoint>(_m_arena);
 			break;
 		default:
 			ZKLOGE("ReadArchive", "Unknown object type: %s", obj.class_name.c_str());
@@ -514,7 +570,7 @@ namespace zenkit {
 				reinterpret_cast<VirtualObject*>(syn.get())->id = obj.index;
 			}
 
-			_m_cache.insert_or_assign(obj.index, syn);
+			this->cache_object(obj.index, syn);
 			syn->load(*this, version);
 		}
 
@@ -526,6 +582,31 @@ namespace zenkit {
 		return syn;
 	}
 
+	void ReadArchive::reserve_objects(std::size_t count) {
+		// Don't trust the header too much.
+		_m_cache.resize(std::min<std::size_t>(count, MAX_DENSE_OBJECTS));
+	}
+
+	void ReadArchive::cache_object(uint32_t index, std::shared_ptr<Object> const& obj) {
+		if (index >= _m_cache.size() && index < std::max<std::size_t>(_m_cache.size() * 2, MIN_DENSE_OBJECTS)) {
+			_m_cache.resize(std::max<std::size_t>(index + 1, _m_cache.size() * 2));
+		}
+
+		if (index < _m_cache.size()) {
+			_m_cache[index] = obj;
+		} else {
+			_m_cache_sparse.insert_or_assign(index, obj);
+		}
+	}
+
+	std::shared_ptr<Object> ReadArchive::find_cached_object(uint32_t index) const {
+		if (index < _m_cache.size() && _m_cache[index] != nullptr) return _m_cache[index];
+		if (_m_cache_sparse.empty()) return nullptr;
+
+		auto it = _m_cache_sparse.find(index);
+		return it == _m_cache_sparse.end() ? nullptr : it->second;
+	}
+
 	void ReadArchive::skip_object(bool skip_current) {
 		ArchiveObject tmp;
 		int32_t level = skip_current ? 1 : 0;
@@ -541,6 +622,211 @@ namespace zenkit {
 		} while (level > 0);
 	}
 
+	bool ReadArchive::read_event(ArchiveEvent& ev) {
+		// Skip over the last entry if it was not read.
+		if (_m_event_entry == read->tell()) {
+			read->seek(static_cast<ssize_t>(_m_event_entry_end), Whence::BEG);
+		}
+
+		_m_event_entry = SIZE_MAX;
+
+		size_t end = 0;
+		if (_m_event_mesh == read->tell()) {
+			// The mesh of a world is stored as raw data in between the object's entries. Binary archives
+			// report it as part of a raw entry already.
+			(void) read->read_uint(); // version
+			auto size = read->read_uint();
+			read->seek(static_cast<ssize_t>(_m_event_mesh), Whence::BEG);
+
+			ev.type = ArchiveEventType::ENTRY;
+			ev.entry = ArchiveEntryType::RAW;
+			ev.name.clear();
+			ev.size = 8 + size_t {size};
+			end = _m_event_mesh + ev.size;
+		} else if (!this->next_event(ev, end)) {
+			ev.type = ArchiveEventType::END;
+			return false;
+		}
+
+		_m_event_mesh = SIZE_MAX;
+
+		if (ev.type == ArchiveEventType::ENTRY) {
+			_m_event_entry = read->tell();
+			_m_event_entry_end = end;
+		} else if (ev.type == ArchiveEventType::OBJECT_BEGIN && ev.object.object_name == "MeshAndBsp" &&
+		           header.format != ArchiveFormat::BINARY) {
+			_m_event_mesh = read->tell();
+		}
+
+		return true;
+	}
+
+	static void copy_raw(Read* r, Write* w, size_t size, std::vector<std::byte>& buffer) {
+		buffer.resize(std::min<size_t>(size, 64 * 1024));
+
+		while (size > 0) {
+			auto n = r->read(buffer.data(), std::min(size, buffer.size()));
+			if (n == 0) throw ParserError {"ReadArchive", "unexpected end of archive in raw data"};
+
+			w->write(buffer.data(), n);
+			size -= n;
+		}
+	}
+
+	void ReadArchive::transcode(Write* w, ArchiveFormat format) {
+		if (header.format == ArchiveFormat::BINARY && format != ArchiveFormat::BINARY) {
+			throw ParserError {"ReadArchive", "binary archives can only be transcoded into binary archives"};
+		}
+
+		auto out = this->is_save_game() ? WriteArchive::to_save(w, format) : WriteArchive::to(w, format);
+		std::vector<std::byte> buffer;
+
+		if (header.format == ArchiveFormat::BINARY) {
+			// Objects within raw entries keep their indices, so only renumbering the objects around them would
+			// break references. Copy everything verbatim instead.
+			auto mark = read->tell();
+			read->seek(0, Whence::END);
+			auto size = read->tell() - mark;
+			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
+
+			copy_raw(read, out->get_stream(), size, buffer);
+
+			auto& bin = static_cast<WriteArchiveBinary&>(*out);
+			bin.set_object_count(static_cast<ReadArchiveBinary&>(*this).get_object_count());
+			bin.write_header();
+			return;
+		}
+
+		// Maps object indices of this archive to the ones in the new archive to be able to rewrite references.
+		std::unordered_map<uint32_t, uint32_t> indices;
+		ArchiveEvent ev;
+
+		while (this->read_event(ev)) {
+			if (ev.type == ArchiveEventType::OBJECT_END) {
+				out->write_object_end();
+				continue;
+			}
+
+			if (ev.type == ArchiveEventType::OBJECT_BEGIN) {
+				auto& obj = ev.object;
+
+				if (obj.class_name == "\xA7") {
+					auto it = indices.find(obj.index);
+					out->write_ref(obj.object_name, it == indices.end() ? obj.index : it->second);
+
+					if (!this->read_event(ev) || ev.type != ArchiveEventType::OBJECT_END) {
+						throw ParserError {"ReadArchive", "Invalid reference object: has children"};
+					}
+
+					continue;
+				}
+
+				auto index = out->write_object_begin(obj.object_name, obj.class_name, obj.version);
+				if (obj.class_name != "%") indices.insert_or_assign(obj.index, index);
+				continue;
+			}
+
+			// Unnamed raw entries are stored in the stream directly, like the mesh of a world.
+			if (ev.entry == ArchiveEntryType::RAW && ev.name.empty()) {
+				copy_raw(read, out->get_stream(), ev.size, buffer);
+				continue;
+			}
+
+			switch (ev.entry) {
+			case ArchiveEntryType::STRING:
+				out->write_string(ev.name, this->read_string());
+				break;
+			case ArchiveEntryType::INTEGER:
+				out->write_int(ev.name, this->read_int());
+				break;
+			case ArchiveEntryType::FLOAT:
+				out->write_float(ev.name, this->read_float());
+				break;
+			case ArchiveEntryType::BYTE:
+				out->write_byte(ev.name, this->read_byte());
+				break;
+			case ArchiveEntryType::WORD:
+				out->write_word(ev.name, this->read_word());
+				break;
+			case ArchiveEntryType::BOOL:
+				out->write_bool(ev.name, this->read_bool());
+				break;
+			case ArchiveEntryType::VEC3:
+				out->write_vec3(ev.name, this->read_vec3());
+				break;
+			case ArchiveEntryType::COLOR:
+				out->write_color(ev.name, this->read_color());
+				break;
+			case ArchiveEntryType::ENUM:
+				out->write_enum(ev.name, this->read_enum());
+				break;
+			case ArchiveEntryType::RAW: {
+				auto raw = this->read_raw(ev.size);
+				buffer.resize(ev.size);
+				buffer.resize(raw->read(buffer.data(), buffer.size()));
+				out->write_raw(ev.name, buffer);
+				break;
+			}
+			case ArchiveEntryType::RAW_FLOAT: {
+				auto values = this->read_raw_float();
+				out->write_raw_float(ev.name, values.data(), static_cast<uint16_t>(values.size()));
+				break;
+			}
+			case ArchiveEntryType::HASH:
+				// Hashes are only ever used as entry keys and are skipped.
+				break;
+			}
+		}
+
+		out->write_header();
+	}
+
+	std::span<ArchiveObjectLocation const> ReadArchive::index_objects() {
+		auto mark = read->tell();
+
+		_m_index.clear();
+		_m_index_lookup.clear();
+		this->scan_objects(_m_index);
+		read->seek(static_cast<ssize_t>(mark), Whence::BEG);
+
+		for (size_t i = 0; i < _m_index.size(); ++i) {
+			auto& obj = _m_index[i].object;
+
+			// References and empty objects don't define an object of their own.
+			if (obj.class_name == "\xA7" || obj.class_name == "%") continue;
+			_m_index_lookup.try_emplace(obj.index, i);
+		}
+
+		return _m_index;
+	}
+
+	ArchiveObjectLocation const* ReadArchive::find_object(std::uint32_t index) const noexcept {
+		auto it = _m_index_lookup.find(index);
+		return it == _m_index_lookup.end() ? nullptr : &_m_index[it->second];
+	}
+
+	void ReadArchive::seek_object(ArchiveObjectLocation const& loc) {
+		read->seek(static_cast<ssize_t>(loc.offset), Whence::BEG);
+	}
+
+	void ReadArchive::scan_objects(std::vector<ArchiveObjectLocation>& out) {
+		ArchiveObject obj;
+		uint32_t depth = 0;
+
+		while (!this->is_at_end()) {
+			auto offset = read->tell();
+
+			if (read_object_begin(obj)) {
+				out.push_back(ArchiveObjectLocation {offset, depth++, obj});
+			} else if (read_object_end()) {
+				if (depth == 0) break;
+				--depth;
+			} else {
+				skip_entry();
+			}
+		}
+	}
+
 	std::unique_ptr<WriteArchive> WriteArchive::to(Write* w, ArchiveFormat format) {
 		switch (format) {
 		case ArchiveFormat::BINARY:
@@ -565,8 +851,8 @@ namespace zenkit {
 	}
 
 	void WriteArchive::write_object(std::string_view name, std::shared_ptr<Object> const& obj, GameVersion version) {
-		if (auto it = _m_cache.find(obj.get()); it != _m_cache.end()) {
-			this->write_ref(name, it->second);
+		if (auto const* index = this->find_cached_object(obj.get()); index != nullptr) {
+			this->write_ref(name, *index);
 			return;
 		}
 
@@ -584,9 +870,46 @@ namespace zenkit {
 		uint16_t obj_version = obj->get_version_identifier(version);
 
 		auto index = this->write_object_begin(name, class_name, obj_version);
-		_m_cache.insert_or_assign(obj, index);
+		this->cache_object(obj, index);
 
 		obj->save(*this, version);
 		this->write_object_end();
 	}
+
+	static std::size_t object_slot(std::vector<std::pair<Object const*, uint32_t>> const& table,
+	                               Object const* obj) noexcept {
+		auto h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(obj)) * 0x9E3779B97F4A7C15ull;
+		auto mask = table.size() - 1;
+		auto i = static_cast<std::size_t>(h >> 32) & mask;
+
+		while (table[i].first != nullptr && table[i].first != obj) {
+			i = (i + 1) & mask;
+		}
+
+		return i;
+	}
+
+	uint32_t const* WriteArchive::find_cached_object(Object const* obj) const noexcept {
+		if (obj == nullptr || _m_cache.empty()) return nullptr;
+
+		auto& slot = _m_cache[object_slot(_m_cache, obj)];
+		return slot.first == nullptr ? nullptr : &slot.second;
+	}
+
+	void WriteArchive::cache_object(Object const* obj, uint32_t index) {
+		// Keep the table at most 3/4 full.
+		if ((_m_cache_count + 1) * 4 > _m_cache.size() * 3) {
+			std::vector<std::pair<Object const*, uint32_t>> table(std::max<std::size_t>(_m_cache.size() * 2, 64));
+
+			for (auto& entry : _m_cache) {
+				if (entry.first != nullptr) table[object_slot(table, entry.first)] = entry;
+			}
+
+			_m_cache = std::move(table);
+		}
+
+		auto& slot = _m_cache[object_slot(_m_cache, obj)];
+		if (slot.first == nullptr) ++_m_cache_count;
+		slot = {obj, index};
+	}
 } // namespace zenkit
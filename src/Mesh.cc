@@ -5,6 +5,7 @@
 #include "zenkit/Stream.hh"
 
 #include <algorithm>
+#include <cstddef>
 #include <unordered_set>
 
 namespace zenkit {
@@ -23,6 +24,10 @@ namespace zenkit {
 		END = 0xB060
 	};
 
+	// Vertex features are read and written in bulk, so their layout must match the on-disk format.
+	static_assert(sizeof(VertexFeature) == 24 && offsetof(VertexFeature, light) == 8 &&
+	              offsetof(VertexFeature, normal) == 12);
+
 	bool PolygonFlagSet::operator==(PolygonFlagSet const& b) const {
 		return is_portal == b.is_portal && is_occluder == b.is_occluder && is_sector == b.is_sector &&
 		    should_relight == b.should_relight && is_outdoor == b.is_outdoor &&
@@ -46,7 +51,7 @@ namespace zenkit {
 			    case MeshChunkType::MARKER:
 				    version = c->read_ushort();
 				    this->date.load(c);
-				    this->name = c->read_line(false);
+				    this->name = c->read_line_view(false);
 				    break;
 			    case MeshChunkType::BBOX:
 				    this->bbox.load(c);
@@ -64,21 +69,11 @@ namespace zenkit {
 			    }
 			    case MeshChunkType::VERTICES:
 				    this->vertices.resize(c->read_uint());
-
-				    for (auto& vertex : this->vertices) {
-					    vertex = c->read_vec3();
-				    }
-
+				    c->read_array<Vec3>(this->vertices);
 				    break;
 			    case MeshChunkType::FEATURES:
 				    this->features.resize(c->read_uint());
-
-				    for (auto& feature : this->features) {
-					    feature.texture = c->read_vec2();
-					    feature.light = c->read_uint();
-					    feature.normal = c->read_vec3();
-				    }
-
+				    c->read_array<VertexFeature>(this->features);
 				    break;
 			    case MeshChunkType::POLYGONS: {
 				    auto poly_count = c->read_uint();
@@ -279,20 +274,12 @@ namespace zenkit {
 
 		proto::write_chunk(w, MeshChunkType::VERTICES, [this](Write* c) {
 			c->write_uint(static_cast<uint32_t>(this->vertices.size()));
-
-			for (auto& v : this->vertices) {
-				c->write_vec3(v);
-			}
+			c->write_array<Vec3>(this->vertices);
 		});
 
 		proto::write_chunk(w, MeshChunkType::FEATURES, [this](Write* c) {
 			c->write_uint(static_cast<uint32_t>(this->features.size()));
-
-			for (auto& feat : this->features) {
-				c->write_vec2(feat.texture);
-				c->write_uint(feat.light);
-				c->write_vec3(feat.normal);
-			}
+			c->write_array<VertexFeature>(this->features);
 		});
 
 		proto::write_chunk(w, MeshChunkType::POLYGONS, [this, version](Write* c) {
@@ -8,7 +8,30 @@
 #include <unistd.h>
 
 namespace zenkit {
-	Mmap::Mmap(std::filesystem::path const& path) {
+	static void mmap_advise(void* addr, size_t len, MmapHint hints) noexcept {
+		if (hints & MmapHint::SEQUENTIAL) {
+			posix_madvise(addr, len, POSIX_MADV_SEQUENTIAL);
+		} else if (hints & MmapHint::RANDOM) {
+			posix_madvise(addr, len, POSIX_MADV_RANDOM);
+		}
+
+#ifdef MAP_POPULATE
+		bool will_need = hints & MmapHint::WILL_NEED;
+#else
+		bool will_need = (hints & MmapHint::WILL_NEED) || (hints & MmapHint::POPULATE);
+#endif
+		if (will_need) {
+			posix_madvise(addr, len, POSIX_MADV_WILLNEED);
+		}
+
+#ifdef MADV_HUGEPAGE
+		if (hints & MmapHint::HUGE_PAGES) {
+			madvise(addr, len, MADV_HUGEPAGE);
+		}
+#endif
+	}
+
+	Mmap::Mmap(std::filesystem::path const& path, MmapHint hints) {
 		auto handle = open(path.c_str(), O_RDONLY);
 
 		if (handle == -1) {
@@ -17,16 +40,35 @@ namespace zenkit {
 
 		struct stat st {};
 		if (fstat(handle, &st) != 0) {
+			close(handle);
 			throw std::runtime_error {"Failed to stat " + path.string()};
 		}
 
-		_m_data =
-		    static_cast<std::byte*>(mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, handle, 0));
-		if (_m_data == nullptr) {
+		int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+		if (hints & MmapHint::POPULATE) {
+			flags |= MAP_POPULATE;
+		}
+#endif
+
+		// Empty files can't be mapped; they are represented by a null mapping of size zero.
+		if (st.st_size == 0) {
+			close(handle);
+			return;
+		}
+
+		auto* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, flags, handle, 0);
+		if (data == MAP_FAILED) {
+			close(handle);
 			throw std::runtime_error {"Failed to mmap " + path.string()};
 		}
 
+		_m_data = static_cast<std::byte*>(data);
 		_m_size = static_cast<std::size_t>(st.st_size);
+		if (hints != MmapHint::NONE) {
+			mmap_advise((void*) _m_data, _m_size, hints);
+		}
+
 		_m_platform_handle = (void*) _m_data;
 
 		close(handle);
@@ -10,15 +10,22 @@ namespace zenkit {
 		HANDLE hFileMapping;
 	};
 
-	Mmap::Mmap(std::filesystem::path const& path) {
+	Mmap::Mmap(std::filesystem::path const& path, MmapHint hints) {
 		HANDLE hFile;
+		DWORD flags = FILE_ATTRIBUTE_NORMAL;
+
+		if (hints & MmapHint::SEQUENTIAL) {
+			flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+		} else if (hints & MmapHint::RANDOM) {
+			flags |= FILE_FLAG_RANDOM_ACCESS;
+		}
 
 		hFile = CreateFileW(path.c_str(),
 		                    GENERIC_READ,
 		                    FILE_SHARE_READ,
 		                    nullptr,
 		                    OPEN_EXISTING,
-		                    FILE_ATTRIBUTE_NORMAL,
+		                    flags,
 		                    nullptr);
 		if (hFile == INVALID_HANDLE_VALUE) {
 			throw std::runtime_error {"Failed to open " + path.string()};
@@ -34,6 +41,14 @@ namespace zenkit {
 
 		_m_data = static_cast<std::byte const*>(MapViewOfFile(hFileMapping, FILE_MAP_READ, 0, 0, 0));
 		_m_platform_handle = new Platform {hFile, hFileMapping};
+
+		// Large pages are not available for file-backed views, so MmapHint::HUGE_PAGES is ignored here.
+#if defined(_WIN32_WINNT_WIN8) && _WIN32_WINNT >= _WIN32_WINNT_WIN8
+		if (_m_data != nullptr && ((hints & MmapHint::WILL_NEED) || (hints & MmapHint::POPULATE))) {
+			WIN32_MEMORY_RANGE_ENTRY range {(PVOID) _m_data, _m_size};
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		}
+#endif
 	}
 
 	Mmap::Mmap(Mmap&& other) noexcept {
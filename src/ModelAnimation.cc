@@ -115,9 +115,7 @@ namespace zenkit {
 				this->checksum = c->read_uint();
 
 				this->node_indices.resize(this->node_count);
-				for (auto& i : this->node_indices) {
-					i = c->read_uint();
-				}
+				c->read_array<uint32_t>(this->node_indices);
 
 				this->samples.resize(this->node_count * this->frame_count);
 				for (auto& i : this->samples) {
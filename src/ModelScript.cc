@@ -203,10 +203,10 @@ namespace zenkit {
 				    anim.next = c->read_line(false);
 				    anim.blend_in = c->read_float();
 				    anim.blend_out = c->read_float();
-				    anim.flags = mds::animation_flags_from_string(c->read_line(false));
+				    anim.flags = mds::animation_flags_from_string(c->read_line_view(false));
 				    anim.model = c->read_line(false);
 				    anim.direction =
-				        c->read_line(false).find('R') == 0 ? AnimationDirection::BACKWARD : AnimationDirection::FORWARD;
+				        c->read_line_view(false).starts_with('R') ? AnimationDirection::BACKWARD : AnimationDirection::FORWARD;
 				    anim.first_frame = c->read_int();
 				    anim.last_frame = c->read_int();
 				    anim.fps = c->read_float();
@@ -223,10 +223,10 @@ namespace zenkit {
 				    alias.next = c->read_line(false);
 				    alias.blend_in = c->read_float();
 				    alias.blend_out = c->read_float();
-				    alias.flags = mds::animation_flags_from_string(c->read_line(false));
+				    alias.flags = mds::animation_flags_from_string(c->read_line_view(false));
 				    alias.alias = c->read_line(false);
 				    alias.direction =
-				        c->read_line(false).find('R') == 0 ? AnimationDirection::BACKWARD : AnimationDirection::FORWARD;
+				        c->read_line_view(false).starts_with('R') ? AnimationDirection::BACKWARD : AnimationDirection::FORWARD;
 				    script.aliases.push_back(std::move(alias));
 				    break;
 			    }
@@ -246,7 +246,7 @@ namespace zenkit {
 				    combo.next = c->read_line(false);
 				    combo.blend_in = c->read_float();
 				    combo.blend_out = c->read_float();
-				    combo.flags = mds::animation_flags_from_string(c->read_line(false));
+				    combo.flags = mds::animation_flags_from_string(c->read_line_view(false));
 				    combo.model = c->read_line(false);
 				    combo.last_frame = c->read_int();
 				    script.combinations.push_back(std::move(combo));
@@ -287,9 +287,12 @@ namespace zenkit {
 				    MdsModelTag tag {};
 				    (void) c->read_int();
 
-				    auto event_type = c->read_line(false);
+				    auto event_type = c->read_line_view(false);
 				    if (event_type != "DEF_HIT_LIMB" && event_type != "HIT_LIMB") {
-					    ZKLOGW("ModelScript", "Unexpected type for modelTag: \"%s\"", event_type.c_str());
+					    ZKLOGW("ModelScript",
+					           "Unexpected type for modelTag: \"%.*s\"",
+					           static_cast<int>(event_type.size()),
+					           event_type.data());
 				    }
 
 				    tag.bone = c->read_line(true);
@@ -319,7 +322,7 @@ namespace zenkit {
 					    event.slot = c->read_line(true);
 					    break;
 				    case MdsEventType::SET_FIGHT_MODE: {
-					    if (auto mode = c->read_line(true); mode == "FIST") {
+					    if (auto mode = c->read_line_view(true); mode == "FIST") {
 						    event.fight_mode = MdsFightMode::FIST;
 					    } else if (mode == "1H" || mode == "1h") {
 						    event.fight_mode = MdsFightMode::SINGLE_HANDED;
@@ -405,13 +408,13 @@ namespace zenkit {
 			    }
 			    case ModelScriptBinaryChunkType::ROOT:
 				    (void) c->read_uint();      // bool
-				    (void) c->read_line(false); // path
+				    (void) c->read_line_view(false); // path
 				    break;
 			    case ModelScriptBinaryChunkType::SOURCE: {
 				    Date d {};
 				    d.load(c);
 
-				    (void) c->read_line(false); // path
+				    (void) c->read_line_view(false); // path
 				    break;
 			    }
 				    // case ModelScriptBinaryChunkType::model:
@@ -36,9 +36,7 @@ namespace zenkit {
 				break;
 			}
 			case MorphMeshChunkType::MORPH:
-				for (auto& morph_position : this->morph_positions) {
-					morph_position = c->read_vec3();
-				}
+				c->read_array<Vec3>(this->morph_positions);
 				break;
 			case MorphMeshChunkType::ANIMATIONS: {
 				auto animation_count = c->read_ushort();
@@ -60,13 +58,8 @@ namespace zenkit {
 					anim.vertices.resize(vertex_count);
 					anim.samples.resize(anim.frame_count * vertex_count);
 
-					for (std::uint32_t j = 0; j < vertex_count; ++j) {
-						anim.vertices[j] = c->read_uint();
-					}
-
-					for (std::uint32_t j = 0; j < vertex_count * anim.frame_count; ++j) {
-						anim.samples[j] = c->read_vec3();
-					}
+					c->read_array<uint32_t>(anim.vertices);
+					c->read_array<Vec3>(anim.samples);
 				}
 				break;
 			}
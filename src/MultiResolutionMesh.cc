@@ -4,12 +4,19 @@
 #include "zenkit/Archive.hh"
 #include "zenkit/Stream.hh"
 
+#include <cstddef>
+
 namespace zenkit {
 	[[maybe_unused]] static constexpr auto VERSION_G1 = 0x305;
 	static constexpr auto VERSION_G2 = 0x905;
 
 	enum class MrmChunkType : std::uint16_t { MESH = 0xB100, END = 0xB1FF };
 
+	// These are read and written in bulk, so their layout must match the on-disk format exactly.
+	static_assert(sizeof(MeshTriangle) == 6 && sizeof(MeshTriangleEdge) == 6 && sizeof(MeshEdge) == 4);
+	static_assert(sizeof(MeshPlane) == 16 && offsetof(MeshPlane, normal) == 4);
+	static_assert(sizeof(MeshWedge) == 24 && offsetof(MeshWedge, texture) == 12 && offsetof(MeshWedge, index) == 20);
+
 	void MultiResolutionMesh::load(Read* r) {
 		proto::read_chunked<MrmChunkType>(r, "MultiResolutionMesh", [this](Read* c, MrmChunkType type) {
 			switch (type) {
@@ -78,16 +85,12 @@ namespace zenkit {
 		// read positions
 		this->positions.resize(vertices_size);
 		r->seek(static_cast<ssize_t>(vertices_offset), Whence::BEG);
-		for (auto& pos : this->positions) {
-			pos = r->read_vec3();
-		}
+		r->read_array<Vec3>(this->positions);
 
 		// read normals
 		this->normals.resize(normals_size);
 		r->seek(static_cast<ssize_t>(normals_offset), Whence::BEG);
-		for (auto& normal : this->normals) {
-			normal = r->read_vec3();
-		}
+		r->read_array<Vec3>(this->normals);
 
 		// read submeshes
 		this->sub_meshes.resize(submesh_count);
@@ -107,29 +110,22 @@ namespace zenkit {
 	void MultiResolutionMesh::save_to_section(Write* w, GameVersion version) const {
 		w->write_ushort(version == GameVersion::GOTHIC_1 ? VERSION_G1 : VERSION_G2);
 
-		auto off_size = static_cast<ssize_t>(w->tell());
-		w->write_uint(0);
+		auto off_size = w->reserve(sizeof(uint32_t));
 
 		auto off_content = w->tell();
 		auto off_positions = w->tell();
-		for (auto& v : this->positions) {
-			w->write_vec3(v);
-		}
+		w->write_array<Vec3>(this->positions);
 
 		auto off_normals = w->tell();
-		for (auto& v : this->normals) {
-			w->write_vec3(v);
-		}
+		w->write_array<Vec3>(this->normals);
 
 		std::vector<SubMeshSection> sections;
 		for (auto& mesh : this->sub_meshes) {
 			sections.push_back(mesh.save(w));
 		}
 
-		auto off_end = static_cast<ssize_t>(w->tell());
-		w->seek(off_size, Whence::BEG);
-		w->write_uint(off_end - off_size);
-		w->seek(off_end, Whence::BEG);
+		auto off_end = w->tell();
+		w->write_uint_at(off_size, off_end - off_size);
 
 		w->write_ubyte(this->sub_meshes.size());    // submeshCount
 		w->write_uint(off_positions - off_content); // positionOffset
@@ -191,76 +187,50 @@ namespace zenkit {
 		// triangles
 		r->seek(static_cast<ssize_t>(map.triangles.offset), Whence::BEG);
 		this->triangles.resize(map.triangles.size);
-		for (auto i = 0u; i < map.triangles.size; ++i) {
-			this->triangles[i] = {{r->read_ushort(), r->read_ushort(), r->read_ushort()}};
-		}
+		r->read_array<MeshTriangle>(this->triangles);
 
 		// wedges
 		r->seek(static_cast<ssize_t>(map.wedges.offset), Whence::BEG);
 		this->wedges.resize(map.wedges.size);
 
-		for (auto i = 0u; i < map.wedges.size; ++i) {
-			this->wedges[i] = {r->read_vec3(), r->read_vec2(), r->read_ushort()};
-
-			// and this is why you don't just dump raw binary data
-			(void) r->read_ushort();
-		}
+		// and this is why you don't just dump raw binary data: the two padding bytes at the end of every wedge happen
+		// to line up with the in-memory padding of `MeshWedge`, so we can read them in bulk anyways.
+		r->read_array<MeshWedge>(this->wedges);
 
 		// colors
 		r->seek(static_cast<ssize_t>(map.colors.offset), Whence::BEG);
 		this->colors.resize(map.colors.size);
-
-		for (auto i = 0u; i < map.colors.size; ++i) {
-			this->colors[i] = r->read_float();
-		}
+		r->read_array<float>(this->colors);
 
 		// triangle_plane_indices
 		r->seek(static_cast<ssize_t>(map.triangle_plane_indices.offset), Whence::BEG);
 		this->triangle_plane_indices.resize(map.triangle_plane_indices.size);
-
-		for (auto i = 0u; i < map.triangle_plane_indices.size; ++i) {
-			this->triangle_plane_indices[i] = r->read_ushort();
-		}
+		r->read_array<uint16_t>(this->triangle_plane_indices);
 
 		// triangle_planes
 		r->seek(static_cast<ssize_t>(map.triangle_planes.offset), Whence::BEG);
 		this->triangle_planes.resize(map.triangle_planes.size);
-
-		for (auto i = 0u; i < map.triangle_planes.size; ++i) {
-			this->triangle_planes[i] = {r->read_float(), r->read_vec3()};
-		}
+		r->read_array<MeshPlane>(this->triangle_planes);
 
 		// triangle_edges
 		r->seek(static_cast<ssize_t>(map.triangle_edges.offset), Whence::BEG);
 		this->triangle_edges.resize(map.triangle_edges.size);
-
-		for (auto i = 0u; i < map.triangle_edges.size; ++i) {
-			this->triangle_edges[i] = {{r->read_ushort(), r->read_ushort(), r->read_ushort()}};
-		}
+		r->read_array<MeshTriangleEdge>(this->triangle_edges);
 
 		// edges
 		r->seek(static_cast<ssize_t>(map.edges.offset), Whence::BEG);
 		this->edges.resize(map.edges.size);
-
-		for (auto i = 0u; i < map.edges.size; ++i) {
-			this->edges[i] = {{r->read_ushort(), r->read_ushort()}};
-		}
+		r->read_array<MeshEdge>(this->edges);
 
 		// edge_scores
 		r->seek(static_cast<ssize_t>(map.edge_scores.offset), Whence::BEG);
 		this->edge_scores.resize(map.edge_scores.size);
-
-		for (auto i = 0u; i < map.edge_scores.size; ++i) {
-			this->edge_scores[i] = r->read_float();
-		}
+		r->read_array<float>(this->edge_scores);
 
 		// wedge_map
 		r->seek(static_cast<ssize_t>(map.wedge_map.offset), Whence::BEG);
 		this->wedge_map.resize(map.wedge_map.size);
-
-		for (auto i = 0u; i < map.wedge_map.size; ++i) {
-			this->wedge_map[i] = r->read_ushort();
-		}
+		r->read_array<uint16_t>(this->wedge_map);
 	}
 
 	SubMeshSection SubMesh::save(Write* w) const {
@@ -268,11 +238,7 @@ namespace zenkit {
 
 		// triangles
 		section.triangles.offset = w->tell();
-		for (auto& tri : this->triangles) {
-			w->write_ushort(tri.wedges[0]);
-			w->write_ushort(tri.wedges[1]);
-			w->write_ushort(tri.wedges[2]);
-		}
+		w->write_array<MeshTriangle>(this->triangles);
 		section.triangles.size = w->tell() - section.triangles.offset;
 
 		// wedges
@@ -287,55 +253,37 @@ namespace zenkit {
 
 		// colors
 		section.colors.offset = w->tell();
-		for (auto color : this->colors) {
-			w->write_float(color);
-		}
+		w->write_array<float>(this->colors);
 		section.colors.size = w->tell() - section.colors.offset;
 
 		// triangle_plane_indices
 		section.triangle_plane_indices.offset = w->tell();
-		for (auto i : this->triangle_plane_indices) {
-			w->write_ushort(i);
-		}
+		w->write_array<uint16_t>(this->triangle_plane_indices);
 		section.triangle_plane_indices.size = w->tell() - section.triangle_plane_indices.offset;
 
 		// triangle_planes
 		section.triangle_planes.offset = w->tell();
-		for (auto& plane : this->triangle_planes) {
-			w->write_float(plane.distance);
-			w->write_vec3(plane.normal);
-		}
+		w->write_array<MeshPlane>(this->triangle_planes);
 		section.triangle_planes.size = w->tell() - section.triangle_planes.offset;
 
 		// triangle_edges
 		section.triangle_edges.offset = w->tell();
-		for (auto& edge : this->triangle_edges) {
-			w->write_ushort(edge.edges[0]);
-			w->write_ushort(edge.edges[1]);
-			w->write_ushort(edge.edges[2]);
-		}
+		w->write_array<MeshTriangleEdge>(this->triangle_edges);
 		section.triangle_edges.size = w->tell() - section.triangle_edges.offset;
 
 		// edges
 		section.edges.offset = w->tell();
-		for (auto edge : edges) {
-			w->write_ushort(edge.edges[0]);
-			w->write_ushort(edge.edges[1]);
-		}
+		w->write_array<MeshEdge>(this->edges);
 		section.edges.size = w->tell() - section.edges.offset;
 
 		// edge_scores
 		section.edge_scores.offset = w->tell();
-		for (auto score : edge_scores) {
-			w->write_float(score);
-		}
+		w->write_array<float>(this->edge_scores);
 		section.edge_scores.size = w->tell() - section.edge_scores.offset;
 
 		// wedge_map
 		section.wedge_map.offset = w->tell();
-		for (auto wedge : this->wedge_map) {
-			w->write_ushort(wedge);
-		}
+		w->write_array<uint16_t>(this->wedge_map);
 		section.wedge_map.size = w->tell() - section.wedge_map.offset;
 
 		return section;
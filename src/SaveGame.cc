@@ -274,6 +274,18 @@ namespace zenkit {
 		return ar->read_object<World>(_m_version);
 	}
 
+	std::shared_ptr<World> SaveGame::load_world(std::string_view world_name, WorldLoadOptions const& options) const {
+		auto path = _m_path / world_name;
+		path.replace_extension("SAV");
+
+		if (!std::filesystem::exists(path)) return nullptr;
+
+		auto r = Read::from(path);
+		auto world = std::make_shared<World>();
+		world->load(r.get(), _m_version, options);
+		return world;
+	}
+
 	void SaveGame::load(std::filesystem::path const& path) {
 		this->_m_path = path;
 
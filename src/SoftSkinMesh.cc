@@ -5,10 +5,15 @@
 
 #include "Internal.hh"
 
+#include <cstddef>
+
 namespace zenkit {
 	constexpr uint32_t VERSION_G1 = 0x00000004;
 	constexpr uint32_t VERSION_G2 = 0x00000004;
 
+	// Wedge normals are read and written in bulk, so their layout must match the on-disk format.
+	static_assert(sizeof(SoftSkinWedgeNormal) == 16 && offsetof(SoftSkinWedgeNormal, index) == 12);
+
 	enum class SoftSkinMeshChunkType : std::uint16_t {
 		HEADER = 0xE100,
 		END = 0xE110,
@@ -50,16 +55,11 @@ namespace zenkit {
 
 				// wedge normals
 				this->wedge_normals.resize(c->read_uint());
-				for (auto& normal : this->wedge_normals) {
-					normal.normal = c->read_vec3();
-					normal.index = c->read_uint();
-				}
+				c->read_array<SoftSkinWedgeNormal>(this->wedge_normals);
 
 				// nodes
 				this->nodes.resize(c->read_ushort());
-				for (auto& node : this->nodes) {
-					node = c->read_int();
-				}
+				c->read_array<int32_t>(this->nodes);
 
 				// bounding boxes
 				this->bboxes.resize(this->nodes.size());
@@ -89,8 +89,7 @@ namespace zenkit {
 		});
 
 		proto::write_chunk(w, SoftSkinMeshChunkType::HEADER, [&](Write* wr) {
-			auto off_size = static_cast<ssize_t>(wr->tell());
-			wr->write_uint(0);
+			auto off_size = wr->reserve(sizeof(uint32_t));
 
 			for (auto& we : this->weights) {
 				wr->write_uint(we.size());
@@ -102,21 +101,14 @@ namespace zenkit {
 				}
 			}
 
-			auto off_end = static_cast<ssize_t>(wr->tell());
-			wr->seek(off_size, Whence::BEG);
-			wr->write_uint(off_end - off_size);
-			wr->seek(off_end, Whence::BEG);
+			auto off_end = wr->tell();
+			wr->write_uint_at(off_size, off_end - off_size);
 
 			wr->write_uint(this->wedge_normals.size());
-			for (auto& n : this->wedge_normals) {
-				wr->write_vec3(n.normal);
-				wr->write_uint(n.index);
-			}
+			wr->write_array<SoftSkinWedgeNormal>(this->wedge_normals);
 
 			wr->write_ushort(this->nodes.size());
-			for (auto n : this->nodes) {
-				wr->write_int(n);
-			}
+			wr->write_array<int32_t>(this->nodes);
 
 			for (auto& bbox : this->bboxes) {
 				bbox.save(wr);
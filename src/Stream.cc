@@ -10,82 +10,102 @@
 #include <fstream>
 
 namespace zenkit {
-	template <typename T>
-	ZKINT T read_any(Read* r) noexcept {
-		T v {};
-		r->read(&v, sizeof v);
-		return v;
-	}
-
 	template <typename T>
 	ZKINT void write_any(Write* r, T const& v) noexcept {
 		r->write(&v, sizeof v);
 	}
 
-	char Read::read_char() noexcept {
-		return read_any<char>(this);
+	Mat3 Read::read_mat3() noexcept {
+		Mat3 v {};
+		this->read_raw(v.pointer(), sizeof(float) * 9);
+		return v.transpose();
 	}
 
-	int8_t Read::read_byte() noexcept {
-		return read_any<int8_t>(this);
+	Mat4 Read::read_mat4() noexcept {
+		Mat4 v {};
+		this->read_raw(v.pointer(), sizeof(float) * 16);
+		return v.transpose();
 	}
 
-	uint8_t Read::read_ubyte() noexcept {
-		return read_any<uint8_t>(this);
+	std::string Read::read_string(size_t len) noexcept {
+		std::string str(len, '\0');
+		this->read_raw(str.data(), len);
+		return str;
 	}
 
-	int16_t Read::read_short() noexcept {
-		return read_any<int16_t>(this);
-	}
+	static constexpr std::string_view READ_LINE_WHITESPACE = " \t\r\n\v\f";
 
-	uint16_t Read::read_ushort() noexcept {
-		return read_any<uint16_t>(this);
+	std::string Read::read_line(bool skipws) noexcept {
+		return read_line_then_ignore(skipws ? READ_LINE_WHITESPACE : std::string_view {});
 	}
 
-	int32_t Read::read_int() noexcept {
-		return read_any<int32_t>(this);
-	}
+	/// \brief Find the first null-byte, carriage return or line feed in the given range.
+	///
+	/// Scans eight bytes at a time using the classic "has zero byte" bit trick, which reports the presence of a zero
+	/// byte in a word exactly. The terminator is then located within the word byte by byte.
+	ZKINT static char const* find_line_end(char const* it, char const* end) noexcept {
+		constexpr uint64_t ONES = 0x0101010101010101;
+		constexpr uint64_t HIGHS = 0x8080808080808080;
 
-	uint32_t Read::read_uint() noexcept {
-		return read_any<uint32_t>(this);
-	}
+		auto has_zero = [](uint64_t v) { return (v - ONES) & ~v & HIGHS; };
 
-	float Read::read_float() noexcept {
-		return read_any<float>(this);
-	}
+		while (end - it >= 8) {
+			uint64_t word;
+			memcpy(&word, it, sizeof word);
 
-	Vec2 Read::read_vec2() noexcept {
-		Vec2 v {};
-		this->read(v.pointer(), sizeof(float) * 2);
-		return v;
-	}
+			if (has_zero(word) | has_zero(word ^ (ONES * '\r')) | has_zero(word ^ (ONES * '\n'))) break;
+			it += 8;
+		}
 
-	Vec3 Read::read_vec3() noexcept {
-		Vec3 v {};
-		this->read(v.pointer(), sizeof(float) * 3);
-		return v;
-	}
+		while (it != end && *it != '\0' && *it != '\r' && *it != '\n') {
+			++it;
+		}
 
-	Mat3 Read::read_mat3() noexcept {
-		Mat3 v {};
-		this->read(v.pointer(), sizeof(float) * 9);
-		return v.transpose();
+		return it;
 	}
 
-	Mat4 Read::read_mat4() noexcept {
-		Mat4 v {};
-		this->read(v.pointer(), sizeof(float) * 16);
-		return v.transpose();
+	/// \brief Read a line directly from the given cursor.
+	/// \note This implements the exact semantics of Read::read_line_then_ignore.
+	ZKINT static std::string_view read_line_cursor(ReadCursor* cursor, std::string_view chars) noexcept {
+		auto const* base = reinterpret_cast<char const*>(cursor->data());
+		auto const* begin = reinterpret_cast<char const*>(cursor->current());
+		auto const* end = begin + cursor->remaining();
+
+		auto const* it = find_line_end(begin, end);
+
+		std::string_view line {begin, static_cast<size_t>(it - begin)};
+
+		// Consume the line terminator, if there is one.
+		if (it != end && *it++ != '\0' && !chars.empty()) {
+			while (it != end && *it != '\0' && chars.find(*it) != std::string_view::npos) {
+				++it;
+			}
+
+			// If we're stopped at a null-byte which is the last byte of the input, consume it as well.
+			if (it != end && *it == '\0' && it + 1 == end) ++it;
+		}
+
+		cursor->seek(static_cast<ssize_t>(it - base), Whence::BEG);
+		return line;
 	}
 
-	std::string Read::read_string(size_t len) noexcept {
-		std::string str(len, '\0');
-		this->read(str.data(), len);
-		return str;
+	std::string_view Read::read_string_view(size_t len) noexcept {
+		if (_m_cursor != nullptr && _m_cursor->remaining() >= len) {
+			std::string_view view {reinterpret_cast<char const*>(_m_cursor->current()), len};
+			_m_cursor->seek(static_cast<ssize_t>(len), Whence::CUR);
+			return view;
+		}
+
+		_m_view_buffer = this->read_string(len);
+		return _m_view_buffer;
 	}
 
-	std::string Read::read_line(bool skipws) noexcept {
-		return read_line_then_ignore(skipws ? " \t\r\n\v\f" : "");
+	std::string_view Read::read_line_view(bool skipws) noexcept {
+		auto chars = skipws ? READ_LINE_WHITESPACE : std::string_view {};
+		if (_m_cursor != nullptr) return read_line_cursor(_m_cursor, chars);
+
+		_m_view_buffer = this->read_line_then_ignore(chars);
+		return _m_view_buffer;
 	}
 
 	std::string Read::read_line_then_ignore(std::string_view chars) noexcept {
@@ -175,6 +195,30 @@ namespace zenkit {
 		this->write(vT.pointer(), 16 * sizeof(float));
 	}
 
+	size_t Write::reserve(size_t len) noexcept {
+		static constexpr std::byte ZEROES[16] {};
+
+		auto off = this->tell();
+		while (len > 0) {
+			auto n = std::min(len, sizeof ZEROES);
+			this->write(ZEROES, n);
+			len -= n;
+		}
+
+		return off;
+	}
+
+	void Write::write_uint_at(size_t off, uint32_t v) noexcept {
+		this->write_at(off, &v, sizeof v);
+	}
+
+	void Write::write_at(size_t off, void const* buf, size_t len) noexcept {
+		auto here = static_cast<ssize_t>(this->tell());
+		this->seek(static_cast<ssize_t>(off), Whence::BEG);
+		this->write(buf, len);
+		this->seek(here, Whence::BEG);
+	}
+
 	namespace detail {
 		constexpr int INTO_C_WHENCE[] = {
 		    SEEK_SET,
@@ -257,34 +301,30 @@ namespace zenkit {
 
 		class ReadMemory ZKINT : public Read {
 		public:
-			ReadMemory(std::byte const* byte, size_t len) : _m_bytes(byte), _m_length(len) {}
+			ReadMemory(std::byte const* byte, size_t len) : Read(&_m_cursor), _m_cursor(byte, len) {}
 
 			size_t read(void* buf, size_t len) noexcept override {
-				len = _m_position + len > _m_length ? _m_length - _m_position : len;
-				memcpy(buf, _m_bytes + _m_position, len);
-				_m_position += len;
-				return len;
+				return _m_cursor.read(buf, len);
 			}
 
 			void seek(ssize_t off, Whence whence) noexcept override {
-				auto new_position = seek_internal(_m_position, _m_length, off, whence);
-
-				if (new_position > _m_length) return;
-
-				_m_position = new_position;
+				_m_cursor.seek(off, whence);
 			}
 
 			[[nodiscard]] size_t tell() const noexcept override {
-				return _m_position;
+				return _m_cursor.tell();
 			}
 
 			[[nodiscard]] bool eof() const noexcept override {
-				return _m_position >= _m_length;
+				return _m_cursor.eof();
+			}
+
+			[[nodiscard]] std::string read_line_then_ignore(std::string_view chars) noexcept override {
+				return std::string {read_line_cursor(&_m_cursor, chars)};
 			}
 
 		private:
-			std::byte const* _m_bytes;
-			size_t _m_length, _m_position {0};
+			ReadCursor _m_cursor;
 		};
 
 		class ReadVector final ZKINT : public ReadMemory {
@@ -299,7 +339,7 @@ namespace zenkit {
 #ifdef _ZK_WITH_MMAP
 		class ReadMmap final ZKINT : public ReadMemory {
 		public:
-			explicit ReadMmap(std::filesystem::path const& path) : ReadMmap(Mmap {path}) {}
+			explicit ReadMmap(std::filesystem::path const& path, MmapHint hints) : ReadMmap(Mmap {path, hints}) {}
 
 			explicit ReadMmap(Mmap mmap) : ReadMemory(mmap.data(), mmap.size()), _m_mmap(std::move(mmap)) {}
 
@@ -324,6 +364,10 @@ namespace zenkit {
 				return static_cast<size_t>(ftell(_m_stream));
 			}
 
+			void flush() noexcept override {
+				fflush(_m_stream);
+			}
+
 		private:
 			FILE* _m_stream;
 		};
@@ -357,6 +401,10 @@ namespace zenkit {
 				return _m_stream->tellp();
 			}
 
+			void flush() noexcept override {
+				_m_stream->flush();
+			}
+
 		private:
 			std::ostream* _m_stream;
 			bool _m_own;
@@ -384,6 +432,11 @@ namespace zenkit {
 				return _m_position;
 			}
 
+			void write_at(size_t off, void const* buf, size_t len) noexcept override {
+				if (off > _m_length) return;
+				memcpy(_m_bytes + off, buf, std::min(len, _m_length - off));
+			}
+
 		private:
 			std::byte* _m_bytes;
 			size_t _m_length, _m_position {0};
@@ -418,10 +471,111 @@ namespace zenkit {
 				return _m_position;
 			}
 
+			void write_at(size_t off, void const* buf, size_t len) noexcept override {
+				if (off + len > _m_vector->size()) {
+					_m_vector->resize(off + len);
+				}
+
+				memcpy(_m_vector->data() + off, buf, len);
+			}
+
 		private:
 			std::vector<std::byte>* _m_vector;
 			size_t _m_position {0};
 		};
+
+		class WriteBuffered final ZKINT : public Write {
+		public:
+			WriteBuffered(Write* sink, std::unique_ptr<Write> owned, size_t capacity)
+			    : _m_sink(sink), _m_owned(std::move(owned)), _m_capacity(capacity), _m_base(sink->tell()) {
+				_m_buffer.reserve(capacity);
+			}
+
+			~WriteBuffered() noexcept override {
+				this->flush();
+			}
+
+			size_t write(void const* buf, size_t len) noexcept override {
+				if (_m_position + len > _m_capacity) {
+					this->flush_buffer();
+
+					// Large writes bypass the buffer entirely.
+					if (len >= _m_capacity) {
+						len = _m_sink->write(buf, len);
+						_m_base += len;
+						return len;
+					}
+				}
+
+				if (_m_position + len > _m_buffer.size()) {
+					_m_buffer.resize(_m_position + len);
+				}
+
+				memcpy(_m_buffer.data() + _m_position, buf, len);
+				_m_position += len;
+				return len;
+			}
+
+			void seek(ssize_t off, Whence whence) noexcept override {
+				if (whence == Whence::END) {
+					this->flush_buffer();
+					_m_sink->seek(off, whence);
+					_m_base = _m_sink->tell();
+					return;
+				}
+
+				auto target = seek_internal(this->tell(), 0, off, whence);
+
+				// Seeking within the buffer does not require any interaction with the sink.
+				if (target >= _m_base && target <= _m_base + _m_buffer.size()) {
+					_m_position = target - _m_base;
+					return;
+				}
+
+				this->flush_buffer();
+				_m_sink->seek(static_cast<ssize_t>(target), Whence::BEG);
+				_m_base = target;
+			}
+
+			[[nodiscard]] size_t tell() const noexcept override {
+				return _m_base + _m_position;
+			}
+
+			void write_at(size_t off, void const* buf, size_t len) noexcept override {
+				if (off >= _m_base && off + len <= _m_base + _m_buffer.size()) {
+					memcpy(_m_buffer.data() + (off - _m_base), buf, len);
+					return;
+				}
+
+				// The slot has (at least partially) been written to the sink already.
+				if (off + len > _m_base) this->flush_buffer();
+				_m_sink->write_at(off, buf, len);
+			}
+
+			void flush() noexcept override {
+				this->flush_buffer();
+				_m_sink->flush();
+			}
+
+		private:
+			void flush_buffer() noexcept {
+				if (_m_buffer.empty()) return;
+
+				_m_sink->write(_m_buffer.data(), _m_buffer.size());
+				if (_m_position != _m_buffer.size()) {
+					_m_sink->seek(static_cast<ssize_t>(_m_base + _m_position), Whence::BEG);
+				}
+
+				_m_base += _m_position;
+				_m_position = 0;
+				_m_buffer.clear();
+			}
+
+			Write* _m_sink;
+			std::unique_ptr<Write> _m_owned;
+			std::vector<std::byte> _m_buffer;
+			size_t _m_capacity, _m_base, _m_position {0};
+		};
 	} // namespace detail
 
 	std::unique_ptr<Read> Read::from(FILE* stream) {
@@ -444,9 +598,9 @@ namespace zenkit {
 		return std::make_unique<detail::ReadVector>(std::move(vector));
 	}
 
-	std::unique_ptr<Read> Read::from(std::filesystem::path const& path) {
+	std::unique_ptr<Read> Read::from(std::filesystem::path const& path, [[maybe_unused]] MmapHint hints) {
 #ifdef _ZK_WITH_MMAP
-		return std::make_unique<detail::ReadMmap>(path);
+		return std::make_unique<detail::ReadMmap>(path, hints);
 #else
 		std::vector<std::byte> data {};
 		std::ifstream stream {path, std::ios::ate | std::ios::binary | std::ios::in};
@@ -459,7 +613,9 @@ namespace zenkit {
 	}
 
 	std::unique_ptr<Write> Write::to(std::filesystem::path const& path) {
-		return std::make_unique<detail::WriteStream>(path);
+		auto sink = std::make_unique<detail::WriteStream>(path);
+		auto* sink_ptr = sink.get();
+		return std::make_unique<detail::WriteBuffered>(sink_ptr, std::move(sink), 1024 * 1024);
 	}
 
 	std::unique_ptr<Write> Write::to(FILE* stream) {
@@ -477,4 +633,8 @@ namespace zenkit {
 	std::unique_ptr<Write> Write::to(std::vector<std::byte>* vector) {
 		return std::make_unique<detail::WriteDynamic>(vector);
 	}
+
+	std::unique_ptr<Write> Write::buffered(Write* sink, size_t capacity) {
+		return std::make_unique<detail::WriteBuffered>(sink, nullptr, std::max(capacity, size_t {1}));
+	}
 } // namespace zenkit
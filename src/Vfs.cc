@@ -8,16 +8,667 @@
 #include "zenkit/Stream.hh"
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <optional>
 #include <stack>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
 namespace zenkit {
 	static constexpr std::string_view VFS_DISK_SIGNATURE_G1 = "PSVDSC_V2.00\r\n\r\n";
 	static constexpr std::string_view VFS_DISK_SIGNATURE_G2 = "PSVDSC_V2.00\n\r\n\r";
 	static constexpr std::string_view VFS_DISK_SIGNATURE_VDFSTOOL = "PSVDSC_V2.00\x1A\x1A\x1A\x1A";
 
+	static constexpr std::uint64_t VFS_PATH_HASH_SEED = 0xCBF29CE484222325;
+	static constexpr std::uint64_t VFS_PATH_HASH_PRIME = 0x100000001B3;
+
+	/// \brief Compare two node names like icompare does in the "C" locale, but without calling into the C library.
+	static bool vfs_icompare(std::string_view a, std::string_view b) noexcept {
+		auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+		auto n = std::min(a.size(), b.size());
+
+		for (size_t i = 0; i < n; ++i) {
+			auto ca = lower(a[i]);
+			auto cb = lower(b[i]);
+			if (ca != cb) return ca < cb;
+		}
+
+		return a.size() < b.size();
+	}
+
+	/// \brief Continue the path hash \p h with the component \p name.
+	///
+	/// The hash is a case-insensitive FNV-1a over the path components, each prefixed by a slash.
+	/// This matches the equality used by VfsNodeComparator and iequals.
+	static std::uint64_t vfs_path_hash(std::uint64_t h, std::string_view name) noexcept {
+		h = (h ^ '/') * VFS_PATH_HASH_PRIME;
+
+		for (auto c : name) {
+			auto u = static_cast<unsigned char>(c);
+			if (u >= 'a' && u <= 'z') u -= 'a' - 'A';
+			h = (h ^ u) * VFS_PATH_HASH_PRIME;
+		}
+
+		return h;
+	}
+
+	/// \brief Get the key of the given extension in the extension index.
+	///
+	/// The key is the extension converted to upper case. A leading wildcard and dot are ignored, so that `TEX`,
+	/// `.tex` and `*.TEX` all produce the same key.
+	static std::string vfs_extension_key(std::string_view extension) {
+		if (extension.starts_with('*')) extension = extension.substr(1);
+		if (extension.starts_with('.')) extension = extension.substr(1);
+
+		std::string key {extension};
+		for (auto& c : key) {
+			if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+		}
+
+		return key;
+	}
+
+	/// \brief Get the extension of the given file name, which is the part after its last dot.
+	static std::string_view vfs_extension(std::string_view name) noexcept {
+		auto dot = name.rfind('.');
+		return dot == std::string_view::npos ? std::string_view {} : name.substr(dot + 1);
+	}
+
+	std::string_view trim_trailing_whitespace(std::string_view s) {
+		while (!s.empty() && std::isspace(s.back())) {
+			s = s.substr(0, s.size() - 1);
+		}
+
+		return s;
+	}
+
+	/// \brief An open-addressing hash multimap from 64-bit hashes to nodes.
+	///
+	/// Colliding hashes are allowed to coexist, so lookups have to check every candidate with a matching hash.
+	/// Removal uses backward-shift deletion to avoid tombstones.
+	class VfsNodeTable {
+	public:
+		void insert(std::uint64_t hash, VfsNode* node) {
+			if ((_m_size + 1) * 2 > _m_slots.size()) {
+				this->grow();
+			}
+
+			auto i = this->home(hash);
+			while (_m_slots[i].node != nullptr) {
+				i = (i + 1) & _m_mask;
+			}
+
+			_m_slots[i] = {hash, node};
+			_m_size += 1;
+		}
+
+		void erase(std::uint64_t hash, VfsNode const* node) noexcept {
+			if (_m_slots.empty()) return;
+
+			auto i = this->home(hash);
+			while (_m_slots[i].node != node) {
+				if (_m_slots[i].node == nullptr) return;
+				i = (i + 1) & _m_mask;
+			}
+
+			// Shift following entries of the probe sequence back into the hole.
+			for (auto j = (i + 1) & _m_mask; _m_slots[j].node != nullptr; j = (j + 1) & _m_mask) {
+				auto home = this->home(_m_slots[j].hash);
+				if (((j - home) & _m_mask) >= ((j - i) & _m_mask)) {
+					_m_slots[i] = _m_slots[j];
+					i = j;
+				}
+			}
+
+			_m_slots[i] = {};
+			_m_size -= 1;
+		}
+
+		/// \brief Call \p cb for every node stored with the given hash.
+		template <typename F>
+		void each(std::uint64_t hash, F cb) const {
+			if (_m_slots.empty()) return;
+
+			for (auto i = this->home(hash); _m_slots[i].node != nullptr; i = (i + 1) & _m_mask) {
+				if (_m_slots[i].hash == hash) cb(_m_slots[i].node);
+			}
+		}
+
+	private:
+		/// \brief Get the preferred slot of the given hash.
+		///
+		/// FNV-1a leaves the low bits of similar strings strongly correlated, so the hash is mixed
+		/// (using the MurmurHash3 finalizer) to avoid long probe sequences.
+		[[nodiscard]] std::uint64_t home(std::uint64_t h) const noexcept {
+			h ^= h >> 33;
+			h *= 0xFF51AFD7ED558CCD;
+			h ^= h >> 33;
+			return h & _m_mask;
+		}
+
+		struct Slot {
+			std::uint64_t hash {0};
+			VfsNode* node {nullptr};
+		};
+
+		void grow() {
+			std::vector<Slot> old(std::max<size_t>(_m_slots.size() * 2, 64));
+			old.swap(_m_slots);
+			_m_mask = _m_slots.size() - 1;
+
+			for (auto& slot : old) {
+				if (slot.node == nullptr) continue;
+
+				auto i = this->home(slot.hash);
+				while (_m_slots[i].node != nullptr) {
+					i = (i + 1) & _m_mask;
+				}
+
+				_m_slots[i] = slot;
+			}
+		}
+
+		std::vector<Slot> _m_slots;
+		std::uint64_t _m_mask {0};
+		std::size_t _m_size {0};
+	};
+
+	/// \brief Lookup tables for all nodes of a Vfs, keyed by their normalized full path and by their name.
+	class VfsIndex {
+	public:
+		/// \brief Add \p node and all of its descendants to the index as children of \p parent.
+		void attach(VfsNode* parent, VfsNode* node) {
+			node->_m_index = this;
+			node->_m_parent = parent;
+			node->_m_path_hash = vfs_path_hash(parent->_m_path_hash, node->name());
+
+			_m_paths.insert(node->_m_path_hash, node);
+			_m_names.insert(vfs_path_hash(VFS_PATH_HASH_SEED, node->name()), node);
+
+			if (auto* nodes = this->extension_list(node); nodes != nullptr) {
+				node->_m_extension_slot = nodes->size();
+				nodes->push_back(node);
+			}
+
+			if (node->type() == VfsNodeType::DIRECTORY) {
+				for (auto& child : node->children()) {
+					this->attach(node, const_cast<VfsNode*>(&child));
+				}
+			}
+		}
+
+		/// \brief Remove \p node and all of its descendants from the index.
+		void detach(VfsNode* node) noexcept {
+			if (auto* nodes = this->extension_list(node); nodes != nullptr) {
+				// Move the last node with the same extension into the slot of the removed one.
+				auto* last = const_cast<VfsNode*>(nodes->back());
+				last->_m_extension_slot = node->_m_extension_slot;
+				(*nodes)[node->_m_extension_slot] = last;
+				nodes->pop_back();
+			}
+
+			if (node->type() == VfsNodeType::DIRECTORY) {
+				for (auto& child : node->children()) {
+					this->detach(const_cast<VfsNode*>(&child));
+				}
+			} else {
+				// The node may be freed after this, so its address must not map to its content any longer.
+				std::scoped_lock lock {_m_contents_lock};
+				_m_contents.erase(node);
+			}
+
+			_m_paths.erase(node->_m_path_hash, node);
+			_m_names.erase(vfs_path_hash(VFS_PATH_HASH_SEED, node->name()), node);
+			node->_m_index = nullptr;
+			node->_m_parent = nullptr;
+		}
+
+		/// \brief Get the cached content identifier of the file \p node, which must be part of this index.
+		[[nodiscard]] std::optional<std::uint64_t> find_content_id(VfsNode const* node) {
+			std::scoped_lock lock {_m_contents_lock};
+
+			auto it = _m_contents.find(node);
+			if (it == _m_contents.end()) return std::nullopt;
+			return it->second;
+		}
+
+		/// \brief Cache the content identifier of the file \p node, which must be part of this index.
+		void set_content_id(VfsNode const* node, std::uint64_t id) {
+			std::scoped_lock lock {_m_contents_lock};
+			_m_contents.insert_or_assign(node, id);
+		}
+
+		/// \brief Find the node at \p path, given the hash of its normalized form.
+		///
+		/// Different paths may have the same hash, so the full path of every candidate is compared.
+		[[nodiscard]] VfsNode* find_path(std::uint64_t hash, std::string_view path) const noexcept {
+			VfsNode* result = nullptr;
+			_m_paths.each(hash, [&](VfsNode* node) {
+				if (result == nullptr && is_at_path(node, path)) result = node;
+			});
+			return result;
+		}
+
+		/// \brief Find the node at the path made up of the trimmed, non-empty \p components.
+		[[nodiscard]] VfsNode* find_path(std::uint64_t hash,
+		                                 std::span<std::string_view const> components) const noexcept {
+			VfsNode* result = nullptr;
+			_m_paths.each(hash, [&](VfsNode* node) {
+				if (result == nullptr && is_at_path(node, components)) result = node;
+			});
+			return result;
+		}
+
+		/// \brief Check whether \p node is at \p path, which is interpreted like Vfs::resolve does.
+		///
+		/// The path is walked from its end while walking up from \p node, so that no components
+		/// have to be collected.
+		static bool is_at_path(VfsNode const* node, std::string_view path) noexcept {
+			for (;;) {
+				auto slash = path.rfind('/');
+				auto component = path.substr(slash + 1);
+
+				if (!component.empty()) {
+					auto name = trim_trailing_whitespace(component);
+					if (name.empty() || node->_m_parent == nullptr || !iequals(node->name(), name)) return false;
+					node = node->_m_parent;
+				}
+
+				if (slash == std::string_view::npos) break;
+				path = path.substr(0, slash);
+			}
+
+			return node->_m_parent == nullptr;
+		}
+
+		/// \brief Check whether \p a and \p b, which may belong to different indices, are at the same path.
+		static bool is_at_same_path(VfsNode const* a, VfsNode const* b) noexcept {
+			for (; a->_m_parent != nullptr && b->_m_parent != nullptr; a = a->_m_parent, b = b->_m_parent) {
+				if (!iequals(a->name(), b->name())) return false;
+			}
+
+			return a->_m_parent == nullptr && b->_m_parent == nullptr;
+		}
+
+		static bool is_at_path(VfsNode const* node, std::span<std::string_view const> components) noexcept {
+			for (auto it = components.rbegin(); it != components.rend(); ++it) {
+				if (node->_m_parent == nullptr || !iequals(node->name(), *it)) return false;
+				node = node->_m_parent;
+			}
+
+			return node->_m_parent == nullptr;
+		}
+
+		/// \brief Find the node named \p name which a depth-first search of the tree would find first.
+		[[nodiscard]] VfsNode* find_name(std::string_view name) const noexcept {
+			VfsNode* result = nullptr;
+			_m_names.each(vfs_path_hash(VFS_PATH_HASH_SEED, name), [&](VfsNode* node) {
+				if (!iequals(node->name(), name)) return;
+				if (result == nullptr || precedes(node, result)) result = node;
+			});
+			return result;
+		}
+
+		/// \brief Get all files with the given extension.
+		[[nodiscard]] std::span<VfsNode const* const> find_extension(std::string_view extension) const {
+			auto it = _m_extensions.find(vfs_extension_key(extension));
+			if (it == _m_extensions.end()) return {};
+			return it->second;
+		}
+
+		/// \brief Get all directories whose name ends in the given extension.
+		[[nodiscard]] std::span<VfsNode const* const> find_directory_extension(std::string_view extension) const {
+			auto it = _m_directory_extensions.find(vfs_extension_key(extension));
+			if (it == _m_directory_extensions.end()) return {};
+			return it->second;
+		}
+
+		/// \brief Check whether \p a comes before \p b in a depth-first traversal of the tree which visits
+		///        the children of each directory in name order.
+		static bool precedes_in_tree(VfsNode const* a, VfsNode const* b) noexcept {
+			auto depth = [](VfsNode const* node) {
+				size_t n = 0;
+				for (; node->_m_parent != nullptr; node = node->_m_parent) ++n;
+				return n;
+			};
+
+			auto da = depth(a);
+			auto db = depth(b);
+
+			for (; da > db; --da) {
+				a = a->_m_parent;
+				if (a == b) return false; // b is an ancestor of a
+			}
+
+			for (; db > da; --db) {
+				b = b->_m_parent;
+				if (a == b) return true; // a is an ancestor of b
+			}
+
+			while (a->_m_parent != b->_m_parent) {
+				a = a->_m_parent;
+				b = b->_m_parent;
+			}
+
+			return a != b && vfs_icompare(a->name(), b->name());
+		}
+
+		/// \brief Find all nodes named \p name in the order a depth-first search of the tree would find them.
+		[[nodiscard]] std::vector<VfsNode*> find_name_all(std::string_view name) const {
+			std::vector<VfsNode*> result;
+			_m_names.each(vfs_path_hash(VFS_PATH_HASH_SEED, name), [&](VfsNode* node) {
+				if (iequals(node->name(), name)) result.push_back(node);
+			});
+
+			std::sort(result.begin(), result.end(), precedes);
+			return result;
+		}
+
+	private:
+		/// \brief Get the extension index \p node belongs to, or `nullptr` if it is not indexed by extension.
+		///
+		/// All files are indexed. Directories are only indexed if their name contains a dot, so that globs
+		/// served by the extension index can find them as well.
+		[[nodiscard]] std::vector<VfsNode const*>* extension_list(VfsNode const* node) {
+			auto key = vfs_extension_key(vfs_extension(node->name()));
+			if (node->type() != VfsNodeType::DIRECTORY) return &_m_extensions[key];
+			if (node->name().find('.') == std::string::npos) return nullptr;
+			return &_m_directory_extensions[key];
+		}
+
+		/// \brief Check whether the depth-first search done by Vfs::find encounters \p a before \p b.
+		///
+		/// The search visits a directory's own children first and then descends into its subdirectories
+		/// in reverse name order, so the node whose parent comes first in that pre-order traversal wins.
+		static bool precedes(VfsNode const* a, VfsNode const* b) noexcept {
+			auto depth = [](VfsNode const* node) {
+				size_t n = 0;
+				for (; node->_m_parent != nullptr; node = node->_m_parent) ++n;
+				return n;
+			};
+
+			auto* p = a->_m_parent;
+			auto* q = b->_m_parent;
+			auto dp = depth(p);
+			auto dq = depth(q);
+
+			// Walk both parents up to their common ancestor, remembering the child of it we came from.
+			VfsNode const* cp = nullptr;
+			VfsNode const* cq = nullptr;
+
+			for (; dp > dq; --dp) cp = std::exchange(p, p->_m_parent);
+			for (; dq > dp; --dq) cq = std::exchange(q, q->_m_parent);
+
+			while (p != q) {
+				cp = std::exchange(p, p->_m_parent);
+				cq = std::exchange(q, q->_m_parent);
+			}
+
+			if (cp == nullptr) return cq != nullptr; // a's parent is an ancestor of b's parent
+			if (cq == nullptr) return false;         // b's parent is an ancestor of a's parent
+			return vfs_icompare(cq->name(), cp->name());
+		}
+
+		VfsNodeTable _m_paths;
+		VfsNodeTable _m_names;
+
+		/// \brief All files, grouped by the key of their extension.
+		std::unordered_map<std::string, std::vector<VfsNode const*>> _m_extensions;
+
+		/// \brief All directories with a dot in their name, grouped by the key of their extension.
+		std::unordered_map<std::string, std::vector<VfsNode const*>> _m_directory_extensions;
+
+		/// \brief The content identifiers of files computed so far.
+		std::unordered_map<VfsNode const*, std::uint64_t> _m_contents;
+		std::mutex _m_contents_lock;
+	};
+
+#ifdef _ZK_WITH_MMAP
+	using VfsHostMapping = Mmap;
+#else
+	using VfsHostMapping = std::vector<std::byte>;
+#endif
+
+	class VfsHostFiles;
+	using VfsHostCache = std::list<std::pair<VfsHostFile*, std::shared_ptr<VfsHostMapping>>>;
+
+	/// \brief A file on the host file system which is mapped into memory on demand.
+	class VfsHostFile {
+	public:
+		VfsHostFile(VfsHostFiles* owner, std::filesystem::path path, std::size_t size)
+		    : _m_owner(owner), _m_path(std::move(path)), _m_size(size) {}
+
+		[[nodiscard]] std::unique_ptr<Read> open();
+
+		/// \brief Map the file into memory.
+		/// \return A mapping of exactly as many bytes as the file had when it was mounted.
+		/// \throws Error if the size of the file has changed since it was mounted.
+		[[nodiscard]] std::shared_ptr<VfsHostMapping> map();
+
+	private:
+		friend class VfsHostFiles;
+
+		VfsHostFiles* _m_owner;
+		std::filesystem::path _m_path;
+		std::size_t _m_size;
+		std::weak_ptr<VfsHostMapping> _m_mapping;
+
+		/// \brief The entry of this file in the mapping cache, if #_m_cached is set.
+		VfsHostCache::iterator _m_cache_entry {};
+		bool _m_cached {false};
+	};
+
+	/// \brief A reader which keeps a host file mapping alive.
+	class ReadHostFile final : public Read {
+	public:
+		explicit ReadHostFile(std::shared_ptr<VfsHostMapping> mapping)
+		    : Read(&_m_cursor), _m_cursor(mapping->data(), mapping->size()), _m_mapping(std::move(mapping)) {}
+
+		size_t read(void* buf, size_t len) noexcept override {
+			return _m_cursor.read(buf, len);
+		}
+
+		void seek(ssize_t off, Whence whence) noexcept override {
+			_m_cursor.seek(off, whence);
+		}
+
+		[[nodiscard]] size_t tell() const noexcept override {
+			return _m_cursor.tell();
+		}
+
+		[[nodiscard]] bool eof() const noexcept override {
+			return _m_cursor.eof();
+		}
+
+	private:
+		ReadCursor _m_cursor;
+		std::shared_ptr<VfsHostMapping> _m_mapping;
+	};
+
+	/// \brief All host files of a Vfs, together with a least-recently-used cache of their mappings.
+	class VfsHostFiles {
+	public:
+		static constexpr std::size_t DEFAULT_LIMIT = 256;
+
+		VfsHostFile* add(std::filesystem::path path, std::size_t size) {
+			std::scoped_lock lock {_m_lock};
+			return &_m_files.emplace_back(this, std::move(path), size);
+		}
+
+		std::unique_ptr<Read> open(VfsHostFile* file) {
+			return std::make_unique<ReadHostFile>(this->map(file));
+		}
+
+		std::shared_ptr<VfsHostMapping> map(VfsHostFile* file) {
+			{
+				std::scoped_lock lock {_m_lock};
+				if (auto mapping = file->_m_mapping.lock(); mapping != nullptr) {
+					this->touch(file, mapping);
+					return mapping;
+				}
+			}
+
+			// Map the file without holding the lock, so that other files can be opened in the meantime.
+			auto mapping = load(*file);
+
+			std::scoped_lock lock {_m_lock};
+
+			// Another thread might have mapped the same file concurrently. Prefer its mapping.
+			if (auto existing = file->_m_mapping.lock(); existing != nullptr) {
+				mapping = std::move(existing);
+			} else {
+				file->_m_mapping = mapping;
+			}
+
+			this->touch(file, mapping);
+			return mapping;
+		}
+
+		void limit(std::size_t limit) {
+			std::scoped_lock lock {_m_lock};
+			_m_limit = limit;
+			this->evict();
+		}
+
+	private:
+		static std::shared_ptr<VfsHostMapping> load(VfsHostFile const& file) {
+#ifdef _ZK_WITH_MMAP
+			auto mapping = std::make_shared<VfsHostMapping>(file._m_path);
+#else
+			std::ifstream stream {file._m_path, std::ios::in | std::ios::ate | std::ios::binary};
+			if (!stream) throw Error {"failed to open host file: " + file._m_path.string()};
+
+			auto mapping = std::make_shared<VfsHostMapping>(static_cast<size_t>(stream.tellg()));
+			stream.seekg(0);
+			stream.read(reinterpret_cast<char*>(mapping->data()), static_cast<std::streamsize>(mapping->size()));
+#endif
+
+			// The Vfs hands out the size of the file as it was when mounted, so any other size can't be served.
+			if (mapping->size() != file._m_size) {
+				throw Error {"host file changed since it was mounted: " + file._m_path.string()};
+			}
+
+			return mapping;
+		}
+
+		/// \brief Mark the mapping of \p file as the most recently used one. The lock must be held.
+		void touch(VfsHostFile* file, std::shared_ptr<VfsHostMapping> const& mapping) {
+			if (file->_m_cached) {
+				_m_cache.splice(_m_cache.begin(), _m_cache, file->_m_cache_entry);
+			} else {
+				_m_cache.emplace_front(file, mapping);
+				file->_m_cache_entry = _m_cache.begin();
+				file->_m_cached = true;
+				this->evict();
+			}
+		}
+
+		void evict() {
+			while (_m_cache.size() > _m_limit) {
+				_m_cache.back().first->_m_cached = false;
+				_m_cache.pop_back();
+			}
+		}
+
+		std::mutex _m_lock;
+		std::deque<VfsHostFile> _m_files;
+		VfsHostCache _m_cache;
+		std::size_t _m_limit {DEFAULT_LIMIT};
+	};
+
+	std::unique_ptr<Read> VfsHostFile::open() {
+		return _m_owner->open(this);
+	}
+
+	std::shared_ptr<VfsHostMapping> VfsHostFile::map() {
+		return _m_owner->map(this);
+	}
+
+	/// \brief Compute the XXH64 hash of the given data.
+	/// \see https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+	static std::uint64_t vfs_content_hash(std::byte const* data, std::size_t size, std::uint64_t seed = 0) noexcept {
+		static constexpr std::uint64_t P1 = 0x9E3779B185EBCA87;
+		static constexpr std::uint64_t P2 = 0xC2B2AE3D27D4EB4F;
+		static constexpr std::uint64_t P3 = 0x165667B19E3779F9;
+		static constexpr std::uint64_t P4 = 0x85EBCA77C2B2AE63;
+		static constexpr std::uint64_t P5 = 0x27D4EB2F165667C5;
+
+		auto read64 = [](std::byte const* p) {
+			std::uint64_t v;
+			std::memcpy(&v, p, sizeof v);
+			return v;
+		};
+
+		auto read32 = [](std::byte const* p) {
+			std::uint32_t v;
+			std::memcpy(&v, p, sizeof v);
+			return v;
+		};
+
+		auto round = [](std::uint64_t acc, std::uint64_t input) {
+			return std::rotl(acc + input * P2, 31) * P1;
+		};
+
+		auto merge = [round](std::uint64_t acc, std::uint64_t val) {
+			return (acc ^ round(0, val)) * P1 + P4;
+		};
+
+		auto* end = data + size;
+		std::uint64_t h;
+
+		if (size >= 32) {
+			std::uint64_t v1 = seed + P1 + P2;
+			std::uint64_t v2 = seed + P2;
+			std::uint64_t v3 = seed;
+			std::uint64_t v4 = seed - P1;
+
+			for (; end - data >= 32; data += 32) {
+				v1 = round(v1, read64(data));
+				v2 = round(v2, read64(data + 8));
+				v3 = round(v3, read64(data + 16));
+				v4 = round(v4, read64(data + 24));
+			}
+
+			h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+			h = merge(merge(merge(merge(h, v1), v2), v3), v4);
+		} else {
+			h = seed + P5;
+		}
+
+		h += size;
+
+		for (; end - data >= 8; data += 8) {
+			h = std::rotl(h ^ round(0, read64(data)), 27) * P1 + P4;
+		}
+
+		if (end - data >= 4) {
+			h = std::rotl(h ^ (read32(data) * P1), 23) * P2 + P3;
+			data += 4;
+		}
+
+		for (; data < end; ++data) {
+			h = std::rotl(h ^ (static_cast<std::uint64_t>(*data) * P5), 11) * P1;
+		}
+
+		h ^= h >> 33;
+		h *= P2;
+		h ^= h >> 29;
+		h *= P3;
+		h ^= h >> 32;
+		return h;
+	}
+
 	VfsBrokenDiskError::VfsBrokenDiskError(std::string const& signature)
 	    : Error("VFS disk signature not recognized: \"" + signature + "\"") {}
 
@@ -26,34 +677,36 @@ namespace zenkit {
 	VfsNotFoundError::VfsNotFoundError(std::string const& name) : Error("not found: \"" + name + "\"") {}
 
 	VfsFileDescriptor::VfsFileDescriptor(std::byte const* mem, size_t len, bool del)
-	    : memory(mem), size(len), refcnt(del ? new size_t(1) : nullptr) {}
+	    : memory(mem), size(len), refcnt(del ? new std::atomic<size_t>(1) : nullptr) {}
+
+	VfsFileDescriptor::VfsFileDescriptor(VfsHostFile* host, size_t len)
+	    : memory(nullptr), size(len), refcnt(nullptr), host(host) {}
 
 	VfsFileDescriptor::VfsFileDescriptor(VfsFileDescriptor const& cpy)
-	    : memory(cpy.memory), size(cpy.size), refcnt(cpy.refcnt) {
+	    : memory(cpy.memory), size(cpy.size), refcnt(cpy.refcnt), host(cpy.host) {
 		if (this->refcnt == nullptr) return;
-		*this->refcnt += 1;
+		this->refcnt->fetch_add(1, std::memory_order_relaxed);
 	}
 
 	VfsFileDescriptor::~VfsFileDescriptor() noexcept {
 		if (this->refcnt == nullptr) return;
-		*this->refcnt -= 1;
 
-		if (*this->refcnt == 0) {
+		if (this->refcnt->fetch_sub(1, std::memory_order_acq_rel) == 1) {
 			delete[] memory;
 			delete this->refcnt;
 		}
 	}
 
 	bool VfsNodeComparator::operator()(VfsNode const& a, VfsNode const& b) const noexcept {
-		return icompare(a.name(), b.name());
+		return vfs_icompare(a.name(), b.name());
 	}
 
 	bool VfsNodeComparator::operator()(VfsNode const& a, std::string_view b) const noexcept {
-		return icompare(a.name(), b);
+		return vfs_icompare(a.name(), b);
 	}
 
 	bool VfsNodeComparator::operator()(std::string_view a, VfsNode const& b) const noexcept {
-		return icompare(a, b.name());
+		return vfs_icompare(a, b.name());
 	}
 
 	VfsNode::VfsNode(std::string_view name, time_t ts) : _m_name(name), _m_time(ts), _m_data(ChildContainer {}) {}
@@ -61,16 +714,43 @@ namespace zenkit {
 	VfsNode::VfsNode(std::string_view name, VfsFileDescriptor dev, time_t ts)
 	    : _m_name(name), _m_time(ts), _m_data(dev) {}
 
-	VfsNode::ChildContainer const& VfsNode::children() const {
-		return std::get<ChildContainer>(_m_data);
+	VfsNode::VfsNode(VfsNode const& cpy) : _m_name(cpy._m_name), _m_time(cpy._m_time), _m_data(cpy._m_data) {}
+
+	VfsNode::VfsNode(VfsNode&& other) noexcept {
+		if (other._m_index != nullptr) other._m_index->detach(&other);
+
+		_m_name = std::move(other._m_name);
+		_m_time = other._m_time;
+		_m_data = std::move(other._m_data);
 	}
 
-	std::string_view trim_trailing_whitespace(std::string_view s) {
-		while (!s.empty() && std::isspace(s.back())) {
-			s = s.substr(0, s.size() - 1);
-		}
+	VfsNode& VfsNode::operator=(VfsNode const& cpy) {
+		if (this == &cpy) return *this;
+		if (_m_index != nullptr) _m_index->detach(this);
 
-		return s;
+		_m_name = cpy._m_name;
+		_m_time = cpy._m_time;
+		_m_data = cpy._m_data;
+		_m_path_hash = 0;
+		_m_parent = nullptr;
+		return *this;
+	}
+
+	VfsNode& VfsNode::operator=(VfsNode&& other) noexcept {
+		if (this == &other) return *this;
+		if (_m_index != nullptr) _m_index->detach(this);
+		if (other._m_index != nullptr) other._m_index->detach(&other);
+
+		_m_name = std::move(other._m_name);
+		_m_time = other._m_time;
+		_m_data = std::move(other._m_data);
+		_m_path_hash = 0;
+		_m_parent = nullptr;
+		return *this;
+	}
+
+	VfsNode::ChildContainer const& VfsNode::children() const {
+		return std::get<ChildContainer>(_m_data);
 	}
 
 	VfsNode const* VfsNode::child(std::string_view name) const {
@@ -92,11 +772,26 @@ namespace zenkit {
 	}
 
 	VfsNode* VfsNode::create(VfsNode node) {
-		this->remove(node.name());
-
 		auto& children = std::get<ChildContainer>(_m_data);
-		auto it = children.insert(std::move(node));
-		return const_cast<VfsNode*>(&*it.first);
+
+		// Replace any existing node with the same name, using the position as the insertion hint.
+		auto name = trim_trailing_whitespace(node.name());
+		auto it = children.lower_bound(name);
+		if (it != children.end() && iequals(it->name(), name)) {
+			if (_m_index != nullptr) {
+				_m_index->detach(const_cast<VfsNode*>(&*it));
+			}
+
+			it = children.erase(it);
+		}
+
+		auto* child = const_cast<VfsNode*>(&*children.emplace_hint(it, std::move(node)));
+
+		if (_m_index != nullptr) {
+			_m_index->attach(this, child);
+		}
+
+		return child;
 	}
 
 	bool VfsNode::remove(std::string_view name) {
@@ -106,12 +801,17 @@ namespace zenkit {
 		auto it = children.find(name);
 		if (it == children.end() || !iequals(it->name(), name)) return false;
 
+		if (_m_index != nullptr) {
+			_m_index->detach(const_cast<VfsNode*>(&*it));
+		}
+
 		children.erase(it);
 		return true;
 	}
 
 	std::unique_ptr<Read> VfsNode::open_read() const {
-		auto fd = std::get<VfsFileDescriptor>(_m_data);
+		auto& fd = std::get<VfsFileDescriptor>(_m_data);
+		if (fd.host != nullptr) return fd.host->open();
 		return Read::from(fd.memory, fd.size);
 	}
 
@@ -143,47 +843,63 @@ namespace zenkit {
 		return _m_name;
 	}
 
-	Vfs::Vfs() : _m_root(VfsNode::directory("/")) {}
+	Vfs::Vfs()
+	    : _m_index(std::make_unique<VfsIndex>()),
+	      _m_root(new VfsNode("/", -1)),
+	      _m_host_files(std::make_shared<VfsHostFiles>()) {
+		_m_root->_m_path_hash = VFS_PATH_HASH_SEED;
+		_m_root->_m_index = _m_index.get();
+	}
+
+	Vfs::Vfs(Vfs&&) noexcept = default;
+	Vfs::~Vfs() noexcept = default;
+
+	Vfs& Vfs::operator=(Vfs&& other) noexcept {
+		if (this == &other) return *this;
+
+		// Release the nodes before the index they refer to.
+		_m_root = std::move(other._m_root);
+		_m_host_files = std::move(other._m_host_files);
+		_m_index = std::move(other._m_index);
+		_m_data = std::move(other._m_data);
+#ifdef _ZK_WITH_MMAP
+		_m_data_mapped = std::move(other._m_data_mapped);
+#endif
+		return *this;
+	}
 
 	VfsNode const* Vfs::resolve(std::string_view path) const noexcept {
-		auto* context = &_m_root;
+		auto hash = VFS_PATH_HASH_SEED;
+		auto full = path;
+		std::string_view name;
 
-		while (context != nullptr && !path.empty()) {
+		while (!path.empty()) {
 			auto next = path.find('/');
 			if (next == 0) {
 				path = path.substr(next + 1);
 				continue;
 			}
 
-			auto name = path.substr(0, next);
-			context = context->child(name);
+			name = trim_trailing_whitespace(path.substr(0, next));
+			if (name.empty()) return nullptr;
 
-			if (next == std::string_view::npos) break;
+			hash = vfs_path_hash(hash, name);
 
+			if (next == std::string_view::npos) break;
 			path = path.substr(next + 1);
 		}
 
-		return context;
+		if (name.empty()) return _m_root.get();
+		return _m_index->find_path(hash, full);
 	}
 
 	VfsNode const* Vfs::find(std::string_view name) const noexcept {
-		std::stack<VfsNode const*> tree {{&_m_root}};
-
-		while (!tree.empty()) {
-			auto* node = tree.top();
-			tree.pop();
-
-			if (auto* child = node->child(name); child != nullptr) return child;
-
-			auto& children = node->children();
-			for (auto const& x : children) {
-				if (x.type() == VfsNodeType::FILE) continue;
-
-				tree.push(&x);
-			}
-		}
+		return _m_index->find_name(trim_trailing_whitespace(name));
+	}
 
-		return nullptr;
+	std::vector<VfsNode const*> Vfs::find_all(std::string_view name) const {
+		auto nodes = _m_index->find_name_all(trim_trailing_whitespace(name));
+		return {nodes.begin(), nodes.end()};
 	}
 
 	VfsNode* Vfs::resolve(std::string_view path) noexcept {
@@ -194,16 +910,173 @@ namespace zenkit {
 		return const_cast<VfsNode*>(const_cast<Vfs const*>(this)->find(name));
 	}
 
-	static uint32_t count_nodes(VfsNode const* node) {
-		uint32_t count = 1; /* self */
+	std::vector<VfsNode*> Vfs::find_all(std::string_view name) {
+		return _m_index->find_name_all(trim_trailing_whitespace(name));
+	}
 
-		if (node->type() == VfsNodeType::DIRECTORY) {
-			for (auto& child : node->children()) {
-				count += count_nodes(&child);
+	std::span<VfsNode const* const> Vfs::with_extension(std::string_view extension) const {
+		return _m_index->find_extension(extension);
+	}
+
+	/// \brief Match a node name against a pattern containing `*` and `?` wildcards, ignoring case.
+	static bool vfs_wildcard_match(std::string_view pattern, std::string_view name) noexcept {
+		auto upper = [](char c) { return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c; };
+
+		std::size_t p = 0;
+		std::size_t n = 0;
+		std::size_t star = std::string_view::npos;
+		std::size_t mark = 0;
+
+		while (n < name.size()) {
+			if (p < pattern.size() && (pattern[p] == '?' || upper(pattern[p]) == upper(name[n]))) {
+				++p;
+				++n;
+			} else if (p < pattern.size() && pattern[p] == '*') {
+				star = p++;
+				mark = n;
+			} else if (star != std::string_view::npos) {
+				// Let the last star consume one more character and try again.
+				p = star + 1;
+				n = ++mark;
+			} else {
+				return false;
 			}
 		}
 
-		return count;
+		while (p < pattern.size() && pattern[p] == '*') {
+			++p;
+		}
+
+		return p == pattern.size();
+	}
+
+	static bool vfs_has_wildcards(std::string_view s) noexcept {
+		return s.find_first_of("*?") != std::string_view::npos;
+	}
+
+	std::vector<VfsNode const*> Vfs::glob(std::string_view pattern) const {
+		std::vector<std::string_view> components;
+		std::size_t recursive = 0;
+
+		while (!pattern.empty()) {
+			auto next = pattern.find('/');
+			auto component = trim_trailing_whitespace(pattern.substr(0, next));
+
+			// Consecutive `**` components are equivalent to a single one.
+			if (!component.empty() && !(component == "**" && !components.empty() && components.back() == "**")) {
+				components.push_back(component);
+				recursive += component == "**";
+			}
+
+			if (next == std::string_view::npos) break;
+			pattern = pattern.substr(next + 1);
+		}
+
+		// Resolve the leading components without wildcards using the path index.
+		VfsNode const* base = _m_root.get();
+		auto hash = VFS_PATH_HASH_SEED;
+		std::size_t first = 0;
+
+		for (; first < components.size() && !vfs_has_wildcards(components[first]); ++first) {
+			if (base->type() != VfsNodeType::DIRECTORY) return {};
+
+			hash = vfs_path_hash(hash, components[first]);
+			base = _m_index->find_path(hash, std::span {components}.first(first + 1));
+			if (base == nullptr) return {};
+		}
+
+		if (first == components.size()) {
+			if (first == 0) return {};
+			return {base};
+		}
+
+		if (base->type() != VfsNodeType::DIRECTORY) return {};
+
+		auto rest = std::span {components}.subspan(first);
+		std::vector<VfsNode const*> result;
+
+		// Serve `**/*.EXT` from the extension index, only keeping the nodes below the base directory.
+		if (rest.size() == 2 && rest[0] == "**" && rest[1].starts_with("*.") && !vfs_has_wildcards(rest[1].substr(2)) &&
+		    rest[1].find('.', 2) == std::string_view::npos) {
+			auto below_base = [base](VfsNode const* node) {
+				auto* parent = node->_m_parent;
+				while (parent != nullptr && parent != base) {
+					parent = parent->_m_parent;
+				}
+
+				return parent != nullptr;
+			};
+
+			auto files = _m_index->find_extension(rest[1]);
+			auto dirs = _m_index->find_directory_extension(rest[1]);
+			std::copy_if(files.begin(), files.end(), std::back_inserter(result), below_base);
+			std::copy_if(dirs.begin(), dirs.end(), std::back_inserter(result), below_base);
+
+			std::sort(result.begin(), result.end(), VfsIndex::precedes_in_tree);
+			return result;
+		}
+
+		std::function<void(VfsNode const*)> collect = [&](VfsNode const* dir) {
+			for (auto& child : dir->children()) {
+				result.push_back(&child);
+				if (child.type() == VfsNodeType::DIRECTORY) collect(&child);
+			}
+		};
+
+		std::function<void(VfsNode const*, std::size_t)> match = [&](VfsNode const* dir, std::size_t i) {
+			auto component = rest[i];
+			auto last = i + 1 == rest.size();
+
+			if (component == "**") {
+				if (last) return collect(dir);
+
+				match(dir, i + 1);
+				for (auto& child : dir->children()) {
+					if (child.type() == VfsNodeType::DIRECTORY) match(&child, i);
+				}
+
+				return;
+			}
+
+			auto visit = [&](VfsNode const* child) {
+				if (last) {
+					result.push_back(child);
+				} else if (child->type() == VfsNodeType::DIRECTORY) {
+					match(child, i + 1);
+				}
+			};
+
+			if (!vfs_has_wildcards(component)) {
+				if (auto* child = dir->child(component)) visit(child);
+				return;
+			}
+
+			for (auto& child : dir->children()) {
+				if (vfs_wildcard_match(component, child.name())) visit(&child);
+			}
+		};
+
+		match(base, 0);
+		std::sort(result.begin(), result.end(), VfsIndex::precedes_in_tree);
+
+		// Multiple `**` components can match the same node in different ways.
+		if (recursive > 1) {
+			result.erase(std::unique(result.begin(), result.end()), result.end());
+		}
+
+		return result;
+	}
+
+	static uint32_t count_nodes(VfsNode const* node) {
+		uint32_t count = 1; /* self */
+
+		if (node->type() == VfsNodeType::DIRECTORY) {
+			for (auto& child : node->children()) {
+				count += count_nodes(&child);
+			}
+		}
+
+		return count;
 	}
 
 	static std::uint32_t vfs_unix_to_dos_time(std::time_t unix_) noexcept {
@@ -220,19 +1093,74 @@ namespace zenkit {
 		return dos;
 	}
 
-	void Vfs::save(Write* w, GameVersion version, time_t unix_t) const {
-		std::vector<std::byte> catalog;
-		auto write_catalog = Write::to(&catalog);
+	/// \brief Touch every page of the given memory so that it is read in from disk.
+	static void vfs_prefault(std::byte const* data, std::size_t size) noexcept {
+		static constexpr std::size_t PAGE_SIZE = 4096;
+
+		std::byte sum {0};
+		for (std::size_t i = 0; i < size; i += PAGE_SIZE) {
+			sum ^= data[i];
+		}
+
+		[[maybe_unused]] std::byte volatile sink = sum;
+	}
+
+	void Vfs::save(Write* w, GameVersion version, time_t unix_t, std::uint32_t alignment, bool deduplicate) const {
+		static constexpr std::size_t STAGING_WINDOW = 64;
+		static constexpr std::byte PADDING[64] {};
+		static constexpr std::uint64_t PADDING_SIZE = sizeof PADDING;
+
+		struct Payload {
+			VfsFileDescriptor const* fd;
+			std::uint32_t offset;
+
+			std::shared_ptr<VfsHostMapping> mapping;
+			std::exception_ptr error;
+			bool ready {false};
+		};
+
+		if (alignment == 0) alignment = 1;
+		auto align = [alignment](std::uint64_t off) { return (off + alignment - 1) / alignment * alignment; };
 
-		// Skip the header, we'll write it at the end.
+		// Lay out the catalog first. All file sizes are known up front, so the offset of every payload can be
+		// assigned right away and the whole archive can be written front to back without seeking.
 		unsigned header_size = 256 + 16 + 6 * 4;
-		unsigned catalog_size = (count_nodes(&_m_root) - 1) * (64 + 4 * 4); // -1 because the root node is not counted
-		w->seek(header_size + catalog_size, Whence::BEG);
+		auto entry_count = count_nodes(_m_root.get()) - 1; // -1 because the root node is not counted
 
-		std::vector<std::byte> cache;
+		std::vector<std::byte> catalog;
+		catalog.reserve(entry_count * (64 + 4 * 4));
+		auto write_catalog = Write::to(&catalog);
+
+		std::vector<Payload> payloads;
+		std::uint64_t offset = header_size + std::uint64_t {entry_count} * (64 + 4 * 4);
+		std::uint32_t index = 0;
+		std::uint32_t files = 0;
 		std::string name;
-		uint32_t index = 0;
-		uint32_t files = 0;
+
+		// Maps content identifiers to the payloads stored with them.
+		std::unordered_multimap<std::uint64_t, std::size_t> contents;
+		if (deduplicate) this->index_contents();
+
+		auto find_duplicate = [&](VfsNode const& node) -> Payload const* {
+			auto& fd = std::get<VfsFileDescriptor>(node._m_data);
+			auto id = this->content_id(node);
+
+			auto [it, end] = contents.equal_range(id);
+			for (; it != end; ++it) {
+				auto& payload = payloads[it->second];
+				if (payload.fd->size != fd.size) continue;
+
+				// Compare the actual contents since the content identifier may collide.
+				std::shared_ptr<VfsHostMapping> mapping_a;
+				std::shared_ptr<VfsHostMapping> mapping_b;
+				auto* a = payload.fd->host != nullptr ? (mapping_a = payload.fd->host->map())->data() : payload.fd->memory;
+				auto* b = fd.host != nullptr ? (mapping_b = fd.host->map())->data() : fd.memory;
+				if (fd.size == 0 || std::memcmp(a, b, fd.size) == 0) return &payload;
+			}
+
+			contents.emplace(id, payloads.size());
+			return nullptr;
+		};
 
 		std::function<void(VfsNode const*)> write_node = [&](VfsNode const* node) {
 			unsigned i = 0;
@@ -245,19 +1173,20 @@ namespace zenkit {
 				write_catalog->write_string(name);
 
 				if (child.type() == VfsNodeType::FILE) {
-					auto rd = child.open_read();
-					rd->seek(0, Whence::END);
-					auto sz = rd->tell();
-					rd->seek(0, Whence::BEG);
-
-					write_catalog->write_uint(w->tell());                                         // Offset
-					write_catalog->write_uint(sz);                                                // Size
+					auto& fd = std::get<VfsFileDescriptor>(child._m_data);
+					auto const* duplicate = deduplicate ? find_duplicate(child) : nullptr;
+
+					if (duplicate == nullptr) {
+						offset = align(offset);
+						payloads.push_back(Payload {&fd, static_cast<std::uint32_t>(offset), nullptr, nullptr});
+						offset += fd.size;
+					}
+
+					auto data_offset = duplicate != nullptr ? duplicate->offset : payloads.back().offset;
+					write_catalog->write_uint(data_offset);                                       // Offset
+					write_catalog->write_uint(static_cast<std::uint32_t>(fd.size));               // Size
 					write_catalog->write_uint(i + 1 == node->children().size() ? 0x40000000 : 0); // Type
 
-					cache.resize(sz);
-					rd->read(cache.data(), sz);
-					w->write(cache.data(), sz);
-
 					files += 1;
 				} else {
 					dirs.emplace_back(write_catalog->tell(), &child);
@@ -273,39 +1202,227 @@ namespace zenkit {
 			}
 
 			for (auto [off, dir] : dirs) {
-				auto here = static_cast<ssize_t>(write_catalog->tell());
-				write_catalog->seek(off, Whence::BEG);
-				write_catalog->write_uint(index);
-				write_catalog->seek(here, Whence::BEG);
-
+				write_catalog->write_uint_at(off, index);
 				write_node(dir);
 			}
 		};
 
-		write_node(&_m_root);
+		write_node(_m_root.get());
+
+		if (offset > UINT32_MAX) {
+			throw Error {"Vfs too large to be saved as a disk: " + std::to_string(offset) + " bytes"};
+		}
 
 		// Write the header
 		std::string comment = "Created using ZenKit";
 		comment.resize(256, '\x1A');
 
-		auto off = w->tell();
-		w->seek(0, Whence::BEG);
 		w->write_string(comment);
 		w->write_string(version == GameVersion::GOTHIC_1 ? VFS_DISK_SIGNATURE_G1 : VFS_DISK_SIGNATURE_G2);
 		w->write_uint(index);
 		w->write_uint(files);
 		w->write_uint(unix_t == 0 ? vfs_unix_to_dos_time(time(nullptr)) : vfs_unix_to_dos_time(unix_t));
-		w->write_uint(off + catalog.size());
+		w->write_uint(static_cast<std::uint32_t>(offset + catalog.size()));
 		w->write_uint(header_size);
 		w->write_uint(80);
-		w->seek(static_cast<ssize_t>(header_size), Whence::BEG);
 		w->write(catalog.data(), catalog.size());
+
+		// Stage the payloads in parallel, slightly ahead of the writer. Staging maps host files and reads the
+		// pages of all file contents into memory, so that the writer never has to wait for the disk.
+		std::mutex lock;
+		std::condition_variable staged;
+		std::condition_variable written;
+		std::size_t next = 0;
+		std::size_t done = 0;
+		bool abort = false;
+
+		auto worker = [&] {
+			std::unique_lock guard {lock};
+
+			while (!abort && next < payloads.size()) {
+				auto i = next++;
+				auto& payload = payloads[i];
+				written.wait(guard, [&] { return abort || i < done + STAGING_WINDOW; });
+				if (abort) break;
+
+				guard.unlock();
+				try {
+					if (payload.fd->host != nullptr) {
+						payload.mapping = payload.fd->host->map();
+						vfs_prefault(payload.mapping->data(), payload.mapping->size());
+					} else {
+						vfs_prefault(payload.fd->memory, payload.fd->size);
+					}
+				} catch (...) {
+					payload.error = std::current_exception();
+				}
+				guard.lock();
+
+				payload.ready = true;
+				staged.notify_all();
+			}
+		};
+
+		auto thread_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 2u) - 1, payloads.size());
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < thread_count; ++i) {
+			threads.emplace_back(worker);
+		}
+
+		auto stop = [&] {
+			{
+				std::scoped_lock guard {lock};
+				abort = true;
+			}
+
+			written.notify_all();
+			for (auto& thread : threads) {
+				thread.join();
+			}
+		};
+
+		try {
+			std::uint64_t position = header_size + catalog.size();
+
+			for (auto& payload : payloads) {
+				{
+					std::unique_lock guard {lock};
+					staged.wait(guard, [&] { return payload.ready || threads.empty(); });
+				}
+
+				// Without worker threads, everything is read by the writer itself.
+				if (threads.empty() && payload.fd->host != nullptr) {
+					payload.mapping = payload.fd->host->map();
+				}
+
+				if (payload.error) std::rethrow_exception(payload.error);
+
+				for (auto pad = payload.offset - position; pad > 0; pad -= std::min(pad, PADDING_SIZE)) {
+					w->write(PADDING, std::min(pad, PADDING_SIZE));
+				}
+
+				// Write directly from the file's memory instead of copying it first.
+				auto* data = payload.mapping != nullptr ? payload.mapping->data() : payload.fd->memory;
+				w->write(data, payload.fd->size);
+				position = payload.offset + payload.fd->size;
+				payload.mapping.reset();
+
+				{
+					std::scoped_lock guard {lock};
+					done += 1;
+				}
+
+				written.notify_all();
+			}
+		} catch (...) {
+			stop();
+			throw;
+		}
+
+		stop();
+	}
+
+	std::uint64_t Vfs::content_id(VfsNode const& node) const {
+		auto& fd = std::get<VfsFileDescriptor>(node._m_data);
+
+		// Identifiers are cached per node, and only for nodes of this Vfs since only those are known to stay alive
+		// until they are removed from its index.
+		auto cacheable = node._m_index == _m_index.get();
+
+		if (cacheable) {
+			if (auto hash = _m_index->find_content_id(&node)) return *hash;
+		}
+
+		std::shared_ptr<VfsHostMapping> mapping;
+		auto* data = fd.host != nullptr ? (mapping = fd.host->map())->data() : fd.memory;
+		auto hash = vfs_content_hash(data, fd.size);
+
+		if (cacheable) _m_index->set_content_id(&node, hash);
+		return hash;
+	}
+
+	void Vfs::index_contents() const {
+		std::vector<VfsNode const*> nodes;
+
+		std::function<void(VfsNode const&)> collect = [&](VfsNode const& dir) {
+			for (auto& child : dir.children()) {
+				if (child.type() == VfsNodeType::DIRECTORY) {
+					collect(child);
+				} else {
+					nodes.push_back(&child);
+				}
+			}
+		};
+
+		collect(*_m_root);
+
+		std::atomic_size_t next {0};
+		std::exception_ptr error;
+		std::mutex error_lock;
+
+		auto worker = [&] {
+			for (auto i = next++; i < nodes.size(); i = next++) {
+				try {
+					(void) this->content_id(*nodes[i]);
+				} catch (...) {
+					std::scoped_lock lock {error_lock};
+					if (!error) error = std::current_exception();
+				}
+			}
+		};
+
+		auto thread_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), nodes.size());
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < thread_count; ++i) {
+			threads.emplace_back(worker);
+		}
+
+		worker();
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		if (error) std::rethrow_exception(error);
 	}
 
-	void Vfs::mount_disk(std::filesystem::path const& host, VfsOverwriteBehavior overwrite) {
+	std::shared_ptr<Vfs const> Vfs::snapshot() const {
+		auto snapshot = std::make_shared<Vfs>();
+		snapshot->_m_host_files = _m_host_files;
+		snapshot->_m_data = _m_data;
 #ifdef _ZK_WITH_MMAP
-		auto& mem = _m_data_mapped.emplace_back(host);
-		this->mount_disk(mem.data(), mem.size(), overwrite);
+		snapshot->_m_data_mapped = _m_data_mapped;
+#endif
+
+		// Children are already sorted, so they can be appended to the copy of their parent directly.
+		std::function<void(VfsNode*, VfsNode const&)> copy_children = [&](VfsNode* parent, VfsNode const& dir) {
+			auto& children = std::get<VfsNode::ChildContainer>(parent->_m_data);
+
+			for (auto& node : dir.children()) {
+				auto* child = const_cast<VfsNode*>(&*children.emplace_hint(
+				    children.end(),
+				    node.type() == VfsNodeType::DIRECTORY
+				        ? VfsNode(node.name(), node.time())
+				        : VfsNode(node.name(), std::get<VfsFileDescriptor>(node._m_data), node.time())));
+				snapshot->_m_index->attach(parent, child);
+
+				if (node.type() == VfsNodeType::DIRECTORY) {
+					copy_children(child, node);
+				} else if (auto id = _m_index->find_content_id(&node)) {
+					snapshot->_m_index->set_content_id(child, *id);
+				}
+			}
+		};
+
+		copy_children(snapshot->_m_root.get(), *_m_root);
+		return snapshot;
+	}
+
+	void Vfs::mount_disk(std::filesystem::path const& host,
+	                     VfsOverwriteBehavior overwrite,
+	                     [[maybe_unused]] MmapHint hints) {
+#ifdef _ZK_WITH_MMAP
+		auto& mem = _m_data_mapped.emplace_back(std::make_shared<Mmap>(host, hints));
+		this->mount_disk(mem->data(), mem->size(), overwrite);
 #else
 		std::ifstream stream {host, std::ios::in | std::ios::ate | std::ios::binary};
 		auto size = stream.tellg();
@@ -343,7 +1460,7 @@ namespace zenkit {
 	}
 
 	VfsNode const& Vfs::root() const noexcept {
-		return _m_root;
+		return *_m_root;
 	}
 
 	void Vfs::mount(VfsNode node, std::string_view parent, VfsOverwriteBehavior overwrite) {
@@ -399,7 +1516,7 @@ namespace zenkit {
 	}
 
 	VfsNode& Vfs::mkdir(std::string_view path) {
-		auto* context = &_m_root;
+		auto* context = _m_root.get();
 
 		while (!path.empty()) {
 			auto next = path.find('/');
@@ -412,7 +1529,7 @@ namespace zenkit {
 
 			if (auto it = context->child(name); it == nullptr) {
 				auto now = std::chrono::system_clock::now();
-				context = context->create(VfsNode::directory(name, std::chrono::system_clock::to_time_t(now)));
+				context = context->create(VfsNode(name, std::chrono::system_clock::to_time_t(now)));
 			} else if (it->type() == VfsNodeType::FILE) {
 				throw VfsFileExistsError {std::string {name}};
 			} else {
@@ -451,24 +1568,12 @@ namespace zenkit {
 				    if (ref.is_directory()) {
 					    VfsNode* newP = parent->create(VfsNode::directory(path.filename().string(), time.count()));
 					    load_directory(newP, path);
-				    } else if (ref.file_size() > 0) {
-#ifdef _ZK_WITH_MMAP
-					    auto& mem = this->_m_data_mapped.emplace_back(path);
+				    } else if (auto size = ref.file_size(); size > 0) {
+					    // The file is only mapped into memory once it is opened.
+					    auto* file = _m_host_files->add(path, static_cast<size_t>(size));
 					    parent->create(VfsNode::file(path.filename().string(),
-					                                 VfsFileDescriptor {mem.data(), mem.size(), false},
+					                                 VfsFileDescriptor {file, static_cast<size_t>(size)},
 					                                 time.count()));
-#else
-					    std::ifstream stream {path, std::ios::in | std::ios::ate | std::ios::binary};
-					    auto size = stream.tellg();
-					    stream.seekg(0);
-
-					    auto& data = _m_data.emplace_back(new std::byte[(size_t) size]);
-					    stream.read((char*) data.get(), size);
-
-					    parent->create(VfsNode::file(path.filename().string(),
-					                                 VfsFileDescriptor {data.get(), static_cast<size_t>(size), false},
-					                                 time.count()));
-#endif
 				    }
 			    }
 		    };
@@ -480,136 +1585,1032 @@ namespace zenkit {
 		}
 	}
 
-	void Vfs::mount_disk(std::byte const* buf, std::size_t size, VfsOverwriteBehavior overwrite) {
-		auto r = Read::from(buf, size);
+	void Vfs::set_host_file_limit(std::size_t limit) {
+		_m_host_files->limit(limit);
+	}
 
+	/// \brief A single decoded entry of a disk catalog.
+	struct VfsDiskEntry {
+		std::string_view name;
+		std::uint32_t offset;
+		std::uint32_t size;
+		std::uint32_t type;
+
+		/// \brief The number of entries following this one which belong to its subtree.
+		std::size_t descendants;
+	};
+
+	/// \brief The decoded catalog of a disk, in the order its entries are visited when mounting it.
+	struct VfsDiskCatalog {
+		std::byte const* data;
+		std::size_t size;
+		std::time_t timestamp;
+		std::string_view signature;
+		std::vector<VfsDiskEntry> entries;
+	};
+
+	/// \brief Directories nested deeper than this are considered to be a broken (likely cyclic) catalog.
+	static constexpr std::size_t VFS_DISK_MAX_DEPTH = 256;
+
+	/// \brief Remove the padding from a name stored in a disk catalog.
+	static std::string_view vfs_trim_disk_name(std::string_view name) noexcept {
+		// Find the first non-space char from the end (refer #77)
+		auto it = std::find_if(name.rbegin(), name.rend(), [](char c) {
+			return !std::isspace(static_cast<unsigned char>(c));
+		});
+
+		if (it != name.rend()) {
+			name = name.substr(0, static_cast<size_t>(name.rend() - it));
+		}
+
+		return name;
+	}
+
+	/// \brief The header of a disk.
+	struct VfsDiskHeader {
+		std::time_t timestamp;
+		std::string_view signature;
+		std::uint32_t entry_count;
+		std::size_t catalog_offset;
+	};
+
+	/// \brief Decode the header of the disk read by \p r and seek to its catalog.
+	/// \throws VfsBrokenDiskError if the disk is not a supported VDF file.
+	static VfsDiskHeader vfs_parse_disk_header(Read* r) {
 		auto comment = r->read_string(256);
 		auto signature = r->read_string(16);
-		[[maybe_unused]] auto entry_count = r->read_uint();
+		auto entry_count = r->read_uint();
 		[[maybe_unused]] auto file_count = r->read_uint();
 		auto timestamp = vfs_dos_to_unix_time(r->read_uint());
 		[[maybe_unused]] auto _size = r->read_uint();
-		auto catalog_offset = r->read_uint();
+		std::size_t catalog_offset = r->read_uint();
 
 		// Check that we're not loading a compressed Union disk.
 		if (r->read_uint() != 80) {
 			throw VfsBrokenDiskError {"Detected unsupported Union disk"};
 		}
 
+		if (signature != VFS_DISK_SIGNATURE_VDFSTOOL && signature != VFS_DISK_SIGNATURE_G1 &&
+		    signature != VFS_DISK_SIGNATURE_G2) {
+			throw VfsBrokenDiskError {signature};
+		}
+
+		if (catalog_offset == 0) {
+			catalog_offset = r->tell();
+		}
+
+		r->seek(static_cast<ssize_t>(catalog_offset), Whence::BEG);
+		return VfsDiskHeader {
+		    timestamp,
+		    signature == VFS_DISK_SIGNATURE_VDFSTOOL ? VFS_DISK_SIGNATURE_VDFSTOOL
+		        : signature == VFS_DISK_SIGNATURE_G1 ? VFS_DISK_SIGNATURE_G1
+		                                             : VFS_DISK_SIGNATURE_G2,
+		    entry_count,
+		    catalog_offset,
+		};
+	}
+
+	static void vfs_parse_catalog_level(Read* r,
+	                                    std::size_t catalog_offset,
+	                                    std::size_t size,
+	                                    std::vector<VfsDiskEntry>& entries,
+	                                    std::size_t depth) {
+		if (depth > VFS_DISK_MAX_DEPTH) {
+			throw VfsBrokenDiskError {"Catalog nesting too deep"};
+		}
+
+		bool last = false;
+		while (!last) {
+			if (r->tell() + 80 > size) {
+				throw VfsBrokenDiskError {"Catalog truncated"};
+			}
+
+			auto e_name = r->read_string_view(64);
+			auto e_offset = r->read_uint();
+			auto e_size = r->read_uint();
+			auto e_type = r->read_uint();
+			[[maybe_unused]] auto attributes = r->read_uint();
+
+			auto index = entries.size();
+			entries.push_back(VfsDiskEntry {vfs_trim_disk_name(e_name), e_offset, e_size, e_type, 0});
+			last = (e_type & 0x40000000) != 0;
+
+			if ((e_type & 0x80000000) != 0) {
+				auto self_offset = r->tell();
+				r->seek(static_cast<ssize_t>(catalog_offset + std::size_t {e_offset} * 80), Whence::BEG);
+				vfs_parse_catalog_level(r, catalog_offset, size, entries, depth + 1);
+				r->seek(static_cast<ssize_t>(self_offset), Whence::BEG);
+
+				entries[index].descendants = entries.size() - index - 1;
+			}
+		}
+	}
+
+	/// \brief Decode the header and catalog of the disk in the given buffer.
+	/// \throws VfsBrokenDiskError if the disk is not a supported VDF file.
+	static VfsDiskCatalog vfs_parse_disk(std::byte const* buf, std::size_t size) {
+		auto r = Read::from(buf, size);
+		auto header = vfs_parse_disk_header(r.get());
+
+		// Logging is deferred to vfs_log_disk since disks may be parsed on worker threads.
+		VfsDiskCatalog catalog {buf, size, header.timestamp, header.signature, {}};
+		vfs_parse_catalog_level(r.get(), header.catalog_offset, size, catalog.entries, 0);
+		return catalog;
+	}
+
+	static void vfs_log_disk(std::string_view signature) {
 		if (signature == VFS_DISK_SIGNATURE_VDFSTOOL) {
 			ZKLOGI("Vfs", "VDFS tool disk detected");
 		} else if (signature == VFS_DISK_SIGNATURE_G1) {
 			ZKLOGD("Vfs", "Gothic 1 disk detected");
-		} else if (signature == VFS_DISK_SIGNATURE_G2) {
-			ZKLOGD("Vfs", "Gothic 2 disk detected");
 		} else {
-			throw VfsBrokenDiskError {signature};
+			ZKLOGD("Vfs", "Gothic 2 disk detected");
 		}
+	}
+
+	/// \brief Merge one directory level of a decoded catalog into \p parent, starting at entry \p i.
+	void Vfs::mount_catalog(VfsNode* parent,
+	                        VfsDiskCatalog const& catalog,
+	                        std::size_t& i,
+	                        VfsOverwriteBehavior overwrite) {
+		auto timestamp = catalog.timestamp;
+
+		bool last = false;
+		while (!last) {
+			auto const& e = catalog.entries[i++];
+
+			VfsNode* existing = parent->child(e.name);
+			bool dir = (e.type & 0x80000000) != 0;
+			last = (e.type & 0x40000000) != 0;
+
+			ZKLOGT("Vfs",
+			       "Parsing node name='%.*s' offset=%x size=%x dir=%d last=%d existing='%s'",
+			       static_cast<int>(e.name.size()),
+			       e.name.data(),
+			       e.offset,
+			       e.size,
+			       dir,
+			       last,
+			       existing == nullptr ? "(NIL)" : existing->name().c_str());
+
+			bool skip = false;
+			if (existing != nullptr && (!dir || existing->type() != VfsNodeType::DIRECTORY)) {
+				switch (overwrite) {
+				case VfsOverwriteBehavior::NONE:
+					skip = true;
+					break;
+				case VfsOverwriteBehavior::NEWER:
+					skip = existing->time() <= timestamp;
+					break;
+				case VfsOverwriteBehavior::OLDER:
+					skip = existing->time() >= timestamp;
+					break;
+				case VfsOverwriteBehavior::ALL:
+					break;
+				}
+			}
 
-		if (auto it = comment.find('\x1A'); it != std::string::npos) {
-			comment.resize(it);
+			if (dir) {
+				if (skip) {
+					i += e.descendants;
+					continue;
+				}
+
+				if (existing == nullptr || existing->type() != VfsNodeType::DIRECTORY) {
+					existing = parent->create(VfsNode(e.name, timestamp));
+				}
+
+				this->mount_catalog(existing, catalog, i, overwrite);
+			} else {
+				if (std::size_t {e.offset} + e.size > catalog.size || skip) {
+					continue;
+				}
+
+				(void) parent->create(
+				    VfsNode::file(e.name, VfsFileDescriptor {catalog.data + e.offset, e.size, false}, timestamp));
+			}
 		}
+	}
 
-		if (catalog_offset == 0) {
-			catalog_offset = r->tell();
+	void Vfs::mount_disk(std::byte const* buf, std::size_t size, VfsOverwriteBehavior overwrite) {
+		auto catalog = vfs_parse_disk(buf, size);
+		vfs_log_disk(catalog.signature);
+
+		std::size_t i = 0;
+		this->mount_catalog(_m_root.get(), catalog, i, overwrite);
+	}
+
+	void Vfs::mount_disks(std::span<std::filesystem::path const> hosts,
+	                      VfsOverwriteBehavior overwrite,
+	                      [[maybe_unused]] MmapHint hints) {
+		struct Disk {
+#ifdef _ZK_WITH_MMAP
+			std::optional<Mmap> mapping;
+#else
+			std::unique_ptr<std::byte[]> data;
+#endif
+			VfsDiskCatalog catalog;
+			std::exception_ptr error;
+		};
+
+		std::vector<Disk> disks(hosts.size());
+		std::atomic_size_t next {0};
+
+		// Map and decode all disks concurrently. Nothing here touches the Vfs itself.
+		auto worker = [&]() {
+			for (auto i = next++; i < disks.size(); i = next++) {
+				auto& disk = disks[i];
+
+				try {
+#ifdef _ZK_WITH_MMAP
+					auto& mem = disk.mapping.emplace(hosts[i], hints);
+					disk.catalog = vfs_parse_disk(mem.data(), mem.size());
+#else
+					std::ifstream stream {hosts[i], std::ios::in | std::ios::ate | std::ios::binary};
+					auto size = stream.tellg();
+					stream.seekg(0);
+
+					disk.data.reset(new std::byte[(size_t) size]);
+					stream.read((char*) disk.data.get(), size);
+					disk.catalog = vfs_parse_disk(disk.data.get(), (size_t) size);
+#endif
+				} catch (...) {
+					disk.error = std::current_exception();
+				}
+			}
+		};
+
+		auto thread_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), disks.size());
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < thread_count; ++i) {
+			threads.emplace_back(worker);
 		}
 
-		std::function<bool(VfsNode*)> load_entry =
-		    [&load_entry, overwrite, catalog_offset, timestamp, &r, buf, size](VfsNode* parent) {
-			    auto e_name = r->read_string(64);
-			    auto e_offset = r->read_uint();
-			    auto e_size = r->read_uint();
-			    auto e_type = r->read_uint();
-			    [[maybe_unused]] auto attributes = r->read_uint();
+		worker();
+		for (auto& thread : threads) {
+			thread.join();
+		}
 
-			    // Find the first non-space char from the end (refer #77)
-			    auto it = std::find_if(e_name.rbegin(), e_name.rend(), [](char c) {
-				    return !std::isspace(static_cast<unsigned char>(c));
-			    });
+		// Merge the disks in order, exactly like mounting them one by one would.
+		for (auto& disk : disks) {
+#ifdef _ZK_WITH_MMAP
+			if (disk.mapping) _m_data_mapped.push_back(std::make_shared<Mmap>(std::move(*disk.mapping)));
+#else
+			if (disk.data) _m_data.push_back(std::move(disk.data));
+#endif
 
-			    if (it != e_name.rend()) {
-				    auto n = e_name.rend() - it;
-				    e_name.resize(static_cast<unsigned long>(n));
-			    }
+			if (disk.error) {
+				std::rethrow_exception(disk.error);
+			}
 
-			    VfsNode* existing = parent->child(e_name);
-			    bool dir = (e_type & 0x80000000) != 0;
-			    bool last = (e_type & 0x40000000) != 0;
-
-			    ZKLOGT("Vfs",
-			           "Parsing node name='%s' offset=%x size=%x dir=%d last=%d existing='%s'",
-			           e_name.c_str(),
-			           e_offset,
-			           e_size,
-			           dir,
-			           last,
-			           existing == nullptr ? "(NIL)" : existing->name().c_str());
-
-			    if (dir) {
-				    if (existing == nullptr) {
-					    existing = parent->create(VfsNode::directory(e_name, timestamp));
-				    } else if (existing->type() != VfsNodeType::DIRECTORY) {
-					    switch (overwrite) {
-					    case VfsOverwriteBehavior::NONE:
-						    return last;
-					    case VfsOverwriteBehavior::NEWER:
-						    if (existing->time() <= timestamp) {
-							    return last;
-						    }
-						    break;
-					    case VfsOverwriteBehavior::OLDER:
-						    if (existing->time() >= timestamp) {
-							    return last;
-						    }
-						    break;
-					    case VfsOverwriteBehavior::ALL:
-						    break;
-					    }
-
-					    parent->remove(e_name);
-					    existing = parent->create(VfsNode::directory(e_name, timestamp));
-				    }
+			vfs_log_disk(disk.catalog.signature);
 
-				    auto self_offset = r->tell();
-				    r->seek(catalog_offset + e_offset * 80, Whence::BEG);
-				    while (!load_entry(existing))
-					    ;
-				    r->seek(static_cast<ssize_t>(self_offset), Whence::BEG);
-			    } else {
-				    if (e_offset + e_size > size) {
-					    return last;
-				    }
+			std::size_t i = 0;
+			this->mount_catalog(_m_root.get(), disk.catalog, i, overwrite);
+		}
+	}
 
-				    if (existing != nullptr) {
-					    switch (overwrite) {
-					    case VfsOverwriteBehavior::NONE:
-						    return last;
-					    case VfsOverwriteBehavior::NEWER:
-						    if (existing->time() <= timestamp) {
-							    return last;
-						    }
-						    break;
-					    case VfsOverwriteBehavior::OLDER:
-						    if (existing->time() >= timestamp) {
-							    return last;
-						    }
-						    break;
-					    case VfsOverwriteBehavior::ALL:
-						    break;
-					    }
-
-					    parent->remove(e_name);
-				    }
+	static constexpr std::string_view VFS_CACHE_MAGIC = "ZKVFSIDX";
+	static constexpr std::uint32_t VFS_CACHE_VERSION = 1;
 
-				    (void) parent->create(
-				        VfsNode::file(e_name, VfsFileDescriptor {buf + e_offset, e_size, false}, timestamp));
-			    }
+	/// \brief Identifies one disk of a mount set stored in a mount cache.
+	struct VfsCacheKey {
+		std::string path;
+		std::uint64_t size;
+		std::int64_t mtime;
+	};
 
-			    return last;
-		    };
+	static std::vector<VfsCacheKey> vfs_cache_keys(std::span<std::filesystem::path const> hosts) {
+		std::vector<VfsCacheKey> keys;
+		keys.reserve(hosts.size());
+
+		for (auto& host : hosts) {
+			std::error_code ec;
+			auto& key = keys.emplace_back();
+			key.path = std::filesystem::absolute(host, ec).lexically_normal().generic_string();
+
+			auto size = std::filesystem::file_size(host, ec);
+			key.size = ec ? UINT64_MAX : size;
 
-		r->seek(catalog_offset, Whence::BEG);
-		while (!load_entry(&_m_root))
-			;
+			auto mtime = std::filesystem::last_write_time(host, ec);
+			key.mtime = ec ? 0 : static_cast<std::int64_t>(mtime.time_since_epoch().count());
+		}
+
+		return keys;
+	}
+
+	static void vfs_write_cache_header(Write* w, std::span<VfsCacheKey const> keys, VfsOverwriteBehavior overwrite) {
+		w->write_string(VFS_CACHE_MAGIC);
+		w->write_uint(VFS_CACHE_VERSION);
+		w->write_uint(static_cast<std::uint32_t>(overwrite));
+		w->write_uint(static_cast<std::uint32_t>(keys.size()));
+
+		for (auto& key : keys) {
+			w->write_uint(static_cast<std::uint32_t>(key.path.size()));
+			w->write_string(key.path);
+			w->write(&key.size, sizeof key.size);
+			w->write(&key.mtime, sizeof key.mtime);
+		}
+	}
+
+	static bool vfs_check_cache_header(Read* r, std::span<VfsCacheKey const> keys, VfsOverwriteBehavior overwrite) {
+		if (r->read_string_view(VFS_CACHE_MAGIC.size()) != VFS_CACHE_MAGIC) return false;
+		if (r->read_uint() != VFS_CACHE_VERSION) return false;
+		if (r->read_uint() != static_cast<std::uint32_t>(overwrite)) return false;
+		if (r->read_uint() != keys.size()) return false;
+
+		for (auto& key : keys) {
+			auto len = r->read_uint();
+			if (len != key.path.size() || r->read_string_view(len) != key.path) return false;
+
+			std::uint64_t size = 0;
+			std::int64_t mtime = 0;
+			r->read(&size, sizeof size);
+			r->read(&mtime, sizeof mtime);
+			if (size != key.size || mtime != key.mtime) return false;
+		}
+
+		return !r->eof();
+	}
+
+	bool Vfs::save_mount_cache(Write* w, std::span<std::pair<std::byte const*, std::size_t> const> disks) const {
+		std::function<bool(VfsNode const&)> write_children = [&](VfsNode const& dir) {
+			w->write_uint(static_cast<std::uint32_t>(dir.children().size()));
+
+			for (auto& child : dir.children()) {
+				std::int64_t time = child.time();
+
+				w->write_ubyte(static_cast<std::uint8_t>(child.type()));
+				w->write_ushort(static_cast<std::uint16_t>(child.name().size()));
+				w->write_string(child.name());
+				w->write(&time, sizeof time);
+
+				if (child.type() == VfsNodeType::DIRECTORY) {
+					if (!write_children(child)) return false;
+					continue;
+				}
+
+				auto& fd = std::get<VfsFileDescriptor>(child._m_data);
+				auto disk = std::find_if(disks.begin(), disks.end(), [&fd](auto& d) {
+					return fd.memory != nullptr && fd.memory >= d.first && fd.memory + fd.size <= d.first + d.second;
+				});
+
+				// Files which don't live in one of the disks can't be cached.
+				if (disk == disks.end()) return false;
+
+				w->write_uint(static_cast<std::uint32_t>(disk - disks.begin()));
+				w->write_uint(static_cast<std::uint32_t>(fd.memory - disk->first));
+				w->write_uint(static_cast<std::uint32_t>(fd.size));
+			}
+
+			return true;
+		};
+
+		return write_children(*_m_root);
+	}
+
+	bool Vfs::load_mount_cache(Read* r, std::span<std::pair<std::byte const*, std::size_t> const> disks) {
+		struct Record {
+			std::string_view name;
+			std::time_t time;
+			bool dir;
+			std::uint32_t children;
+			std::uint32_t disk;
+			std::uint32_t offset;
+			std::uint32_t size;
+		};
+
+		auto start = r->tell();
+		r->seek(0, Whence::END);
+		auto end = r->tell();
+		r->seek(static_cast<ssize_t>(start), Whence::BEG);
+
+		auto fits = [r, end](std::size_t len) { return r->tell() + len <= end; };
+
+		// Decode and validate all records before touching the tree, so that a broken cache leaves it empty.
+		std::vector<Record> records;
+		std::vector<std::pair<std::uint32_t, std::string_view>> levels; // remaining children, previous name
+
+		if (!fits(4)) return false;
+		levels.emplace_back(r->read_uint(), std::string_view {});
+
+		while (!levels.empty()) {
+			if (levels.back().first == 0) {
+				levels.pop_back();
+				continue;
+			}
+
+			levels.back().first -= 1;
+			if (!fits(3)) return false;
+
+			auto& rec = records.emplace_back();
+			auto type = r->read_ubyte();
+			auto name_length = r->read_ushort();
+			rec.dir = type == static_cast<std::uint8_t>(VfsNodeType::DIRECTORY);
+			if (!fits(name_length + sizeof(std::int64_t) + (rec.dir ? 4 : 12))) return false;
+
+			rec.name = r->read_string_view(name_length);
+
+			std::int64_t time = 0;
+			r->read(&time, sizeof time);
+			rec.time = static_cast<std::time_t>(time);
+
+			// Siblings must be unique and sorted like the child container sorts them.
+			auto& previous = levels.back().second;
+			if (!previous.empty() && !vfs_icompare(previous, rec.name)) return false;
+			if (rec.name.empty()) return false;
+			previous = rec.name;
+
+			if (rec.dir) {
+				rec.children = r->read_uint();
+				levels.emplace_back(rec.children, std::string_view {});
+			} else if (type == static_cast<std::uint8_t>(VfsNodeType::FILE)) {
+				rec.disk = r->read_uint();
+				rec.offset = r->read_uint();
+				rec.size = r->read_uint();
+
+				if (rec.disk >= disks.size() || std::size_t {rec.offset} + rec.size > disks[rec.disk].second) {
+					return false;
+				}
+			} else {
+				return false;
+			}
+		}
+
+		// All records are already sorted, so every node can be appended to its parent directly.
+		std::vector<std::pair<VfsNode*, std::uint32_t>> parents {{_m_root.get(), UINT32_MAX}};
+		for (auto& rec : records) {
+			while (parents.back().second == 0) {
+				parents.pop_back();
+			}
+
+			auto* parent = parents.back().first;
+			parents.back().second -= 1;
+
+			auto& children = std::get<VfsNode::ChildContainer>(parent->_m_data);
+			auto* child = const_cast<VfsNode*>(&*children.emplace_hint(
+			    children.end(),
+			    rec.dir ? VfsNode(rec.name, rec.time)
+			            : VfsNode(rec.name,
+			                      VfsFileDescriptor {disks[rec.disk].first + rec.offset, rec.size, false},
+			                      rec.time)));
+			_m_index->attach(parent, child);
+
+			if (rec.dir) {
+				parents.emplace_back(child, rec.children);
+			}
+		}
+
+		return true;
+	}
+
+	void Vfs::mount_disks(std::span<std::filesystem::path const> hosts,
+	                      std::filesystem::path const& cache,
+	                      VfsOverwriteBehavior overwrite,
+	                      MmapHint hints) {
+		if (!_m_root->children().empty()) {
+			ZKLOGW("Vfs", "Not using the mount cache since the file system is not empty");
+			this->mount_disks(hosts, overwrite, hints);
+			return;
+		}
+
+		auto keys = vfs_cache_keys(hosts);
+		std::vector<std::pair<std::byte const*, std::size_t>> disks;
+
+		std::error_code ec;
+		if (std::filesystem::is_regular_file(cache, ec)) {
+			try {
+				auto r = Read::from(cache, MmapHint::SEQUENTIAL);
+
+				if (vfs_check_cache_header(r.get(), keys, overwrite)) {
+#ifdef _ZK_WITH_MMAP
+					std::vector<Mmap> mapped;
+					for (auto& host : hosts) {
+						auto& mem = mapped.emplace_back(host, hints);
+						disks.emplace_back(mem.data(), mem.size());
+					}
+#else
+					std::vector<std::unique_ptr<std::byte[]>> mapped;
+					for (auto& host : hosts) {
+						std::ifstream stream {host, std::ios::in | std::ios::ate | std::ios::binary};
+						auto size = stream.tellg();
+						stream.seekg(0);
+
+						auto& data = mapped.emplace_back(new std::byte[(size_t) size]);
+						stream.read((char*) data.get(), size);
+						disks.emplace_back(data.get(), (size_t) size);
+					}
+#endif
+
+					if (this->load_mount_cache(r.get(), disks)) {
+#ifdef _ZK_WITH_MMAP
+						for (auto& mem : mapped) {
+							_m_data_mapped.push_back(std::make_shared<Mmap>(std::move(mem)));
+						}
+#else
+						std::move(mapped.begin(), mapped.end(), std::back_inserter(_m_data));
+#endif
+						ZKLOGD("Vfs", "Loaded %zu disks from mount cache", hosts.size());
+						return;
+					}
+				}
+			} catch (std::exception const& e) {
+				ZKLOGW("Vfs", "Failed to read mount cache: %s", e.what());
+			}
+
+			ZKLOGI("Vfs", "Mount cache is stale, rebuilding it");
+		}
+
+		disks.clear();
+
+#ifdef _ZK_WITH_MMAP
+		auto first = _m_data_mapped.size();
+		this->mount_disks(hosts, overwrite, hints);
+
+		for (auto i = first; i < _m_data_mapped.size(); ++i) {
+			disks.emplace_back(_m_data_mapped[i]->data(), _m_data_mapped[i]->size());
+		}
+#else
+		auto first = _m_data.size();
+		this->mount_disks(hosts, overwrite, hints);
+
+		for (auto i = first; i < _m_data.size(); ++i) {
+			disks.emplace_back(_m_data[i].get(), keys[i - first].size);
+		}
+#endif
+
+		std::vector<std::byte> buffer;
+		auto w = Write::to(&buffer);
+		vfs_write_cache_header(w.get(), keys, overwrite);
+
+		if (!this->save_mount_cache(w.get(), disks)) {
+			ZKLOGW("Vfs", "Not writing the mount cache since the file system contains foreign files");
+			return;
+		}
+
+		// Write to a temporary file first so that concurrent processes never see a partial cache.
+		auto tmp = cache;
+		tmp += ".tmp";
+
+		std::ofstream out {tmp, std::ios::binary | std::ios::out | std::ios::trunc};
+		out.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		out.close();
+
+		if (!out || (std::filesystem::rename(tmp, cache, ec), ec)) {
+			ZKLOGW("Vfs", "Failed to write mount cache");
+			std::filesystem::remove(tmp, ec);
+		}
+	}
+
+	/// \brief A disk loaded into a VfsCompact, whose catalog is read in place.
+	struct VfsCompactDisk {
+		std::byte const* data;
+		std::size_t size;
+		VfsDiskHeader header;
+
+		/// \brief Decode the entry at \p index of the catalog.
+		/// \throws VfsBrokenDiskError if the entry lies outside of the disk.
+		[[nodiscard]] VfsDiskEntry entry(std::size_t index) const {
+			auto offset = header.catalog_offset + index * 80;
+			if (offset + 80 > size) {
+				throw VfsBrokenDiskError {"Catalog truncated"};
+			}
+
+			auto* e = data + offset;
+			std::uint32_t fields[3];
+			std::memcpy(fields, e + 64, sizeof fields);
+
+			auto name = std::string_view {reinterpret_cast<char const*>(e), 64};
+			return VfsDiskEntry {vfs_trim_disk_name(name), fields[0], fields[1], fields[2], 0};
+		}
+
+		/// \brief Get the maximum number of entries of the catalog.
+		[[nodiscard]] std::size_t capacity() const noexcept {
+			if (header.catalog_offset >= size) return 0;
+			return std::min<std::size_t>(header.entry_count, (size - header.catalog_offset) / 80);
+		}
+	};
+
+	VfsNodeType VfsCompactNode::type() const noexcept {
+		return _m_directory ? VfsNodeType::DIRECTORY : VfsNodeType::FILE;
+	}
+
+	std::time_t VfsCompactNode::time() const noexcept {
+		return _m_time;
+	}
+
+	std::string_view VfsCompactNode::name() const noexcept {
+		return {_m_name, _m_name_size};
+	}
+
+	std::span<VfsCompactNode const> VfsCompactNode::children() const noexcept {
+		if (!_m_directory) return {};
+		return {_m_children, _m_size};
+	}
+
+	VfsCompactNode const* VfsCompactNode::child(std::string_view name) const noexcept {
+		auto children = this->children();
+
+		name = trim_trailing_whitespace(name);
+		auto it = std::lower_bound(children.begin(), children.end(), name, [](VfsCompactNode const& a, auto b) {
+			return vfs_icompare(a.name(), b);
+		});
+
+		if (it == children.end() || !iequals(it->name(), name)) return nullptr;
+		return &*it;
+	}
+
+	std::unique_ptr<Read> VfsCompactNode::open_read() const {
+		if (_m_directory) throw std::bad_variant_access {};
+		return Read::from(_m_memory, _m_size);
+	}
+
+	VfsCompact::VfsCompact() {
+		auto& root = _m_nodes.emplace_back();
+		root._m_name = "/";
+		root._m_name_size = 1;
+		root._m_children = nullptr;
+		root._m_time = -1;
+		root._m_size = 0;
+		root._m_directory = true;
+	}
+
+	VfsCompact::VfsCompact(VfsCompact&&) noexcept = default;
+	VfsCompact::~VfsCompact() noexcept = default;
+	VfsCompact& VfsCompact::operator=(VfsCompact&&) noexcept = default;
+
+	VfsCompact VfsCompact::from_disks(std::span<std::filesystem::path const> hosts,
+	                                  VfsOverwriteBehavior overwrite,
+	                                  [[maybe_unused]] MmapHint hints) {
+		VfsCompact vfs;
+		std::vector<VfsCompactDisk> disks;
+
+		for (auto& host : hosts) {
+#ifdef _ZK_WITH_MMAP
+			auto& mem = vfs._m_data_mapped.emplace_back(std::make_shared<Mmap>(host, hints));
+			auto* data = mem->data();
+			auto size = mem->size();
+#else
+			std::ifstream stream {host, std::ios::in | std::ios::ate | std::ios::binary};
+			auto size = static_cast<size_t>(stream.tellg());
+			stream.seekg(0);
+
+			auto* data = vfs._m_data.emplace_back(new std::byte[size]).get();
+			stream.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size));
+#endif
+
+			auto r = Read::from(data, size);
+			auto& disk = disks.emplace_back(VfsCompactDisk {data, size, vfs_parse_disk_header(r.get())});
+			vfs_log_disk(disk.header.signature);
+		}
+
+		vfs.build(disks, overwrite);
+		return vfs;
+	}
+
+	void VfsCompact::build(std::span<VfsCompactDisk const> disks, VfsOverwriteBehavior overwrite) {
+		/// The entries of one directory level of a disk, starting at the given catalog index.
+		struct Level {
+			std::uint32_t disk;
+			std::size_t first;
+		};
+
+		/// A directory whose children still have to be added, made up of the levels in the given range.
+		struct Directory {
+			std::size_t node;
+			std::size_t levels_begin;
+			std::size_t levels_end;
+			std::size_t depth;
+			std::size_t first_child;
+		};
+
+		struct Entry {
+			VfsDiskEntry entry;
+			std::uint32_t disk;
+		};
+
+		auto skip = [overwrite](std::time_t existing, std::time_t timestamp) {
+			switch (overwrite) {
+			case VfsOverwriteBehavior::NONE:
+				return true;
+			case VfsOverwriteBehavior::NEWER:
+				return existing <= timestamp;
+			case VfsOverwriteBehavior::OLDER:
+				return existing >= timestamp;
+			case VfsOverwriteBehavior::ALL:
+				break;
+			}
+
+			return false;
+		};
+
+		std::size_t capacity = _m_nodes.size();
+		std::vector<Level> levels;
+		for (std::uint32_t i = 0; i < disks.size(); ++i) {
+			capacity += disks[i].capacity();
+			levels.push_back(Level {i, 0});
+		}
+
+		_m_nodes.reserve(capacity);
+
+		// Directories are filled in breadth-first order, so that the children of each directory can be appended
+		// to the node array in one go. Nodes are referred to by their index until the array is complete.
+		std::vector<Directory> directories {Directory {0, 0, levels.size(), 0, 0}};
+		std::vector<Entry> entries;
+		std::vector<Level> merged;
+
+		for (std::size_t d = 0; d < directories.size(); ++d) {
+			auto dir = directories[d];
+			if (dir.depth > VFS_DISK_MAX_DEPTH) {
+				throw VfsBrokenDiskError {"Catalog nesting too deep"};
+			}
+
+			// Collect the entries of all levels making up the directory, in mounting order.
+			entries.clear();
+			for (auto l = dir.levels_begin; l < dir.levels_end; ++l) {
+				auto level = levels[l];
+				auto& disk = disks[level.disk];
+
+				for (auto i = level.first;; ++i) {
+					auto& e = entries.emplace_back(Entry {disk.entry(i), level.disk});
+					if ((e.entry.type & 0x40000000) != 0) break;
+				}
+			}
+
+			// Group entries with the same name while keeping them in mounting order, so that each group can be
+			// merged just like mounting the disks one after the other would.
+			std::stable_sort(entries.begin(), entries.end(), [](Entry const& a, Entry const& b) {
+				return vfs_icompare(a.entry.name, b.entry.name);
+			});
+
+			directories[d].first_child = _m_nodes.size();
+
+			for (auto it = entries.begin(); it != entries.end();) {
+				auto end = std::find_if(it + 1, entries.end(), [&](Entry const& e) {
+					return vfs_icompare(it->entry.name, e.entry.name);
+				});
+
+				Entry const* node = nullptr;
+				bool is_directory = false;
+				std::time_t time = 0;
+				merged.clear();
+
+				for (; it != end; ++it) {
+					auto& disk = disks[it->disk];
+					auto timestamp = disk.header.timestamp;
+					bool directory = (it->entry.type & 0x80000000) != 0;
+					bool skipped = node != nullptr && (!directory || !is_directory) && skip(time, timestamp);
+
+					if (directory) {
+						if (skipped) continue;
+
+						// Directories replace files but are merged with existing directories.
+						if (node == nullptr || !is_directory) {
+							node = &*it;
+							is_directory = true;
+							time = timestamp;
+							merged.clear();
+						}
+
+						merged.push_back(Level {it->disk, it->entry.offset});
+					} else {
+						if (std::size_t {it->entry.offset} + it->entry.size > disk.size || skipped) continue;
+
+						node = &*it;
+						is_directory = false;
+						time = timestamp;
+						merged.clear();
+					}
+				}
+
+				if (node == nullptr) continue;
+
+				auto& child = _m_nodes.emplace_back();
+				child._m_name = node->entry.name.data();
+				child._m_name_size = static_cast<std::uint8_t>(node->entry.name.size());
+				child._m_time = time;
+				child._m_directory = is_directory;
+
+				if (is_directory) {
+					child._m_children = nullptr;
+					child._m_size = 0;
+
+					directories.push_back(Directory {_m_nodes.size() - 1,
+					                                 levels.size(),
+					                                 levels.size() + merged.size(),
+					                                 dir.depth + 1,
+					                                 0});
+					levels.insert(levels.end(), merged.begin(), merged.end());
+				} else {
+					child._m_memory = disks[node->disk].data + node->entry.offset;
+					child._m_size = node->entry.size;
+				}
+			}
+
+			_m_nodes[dir.node]._m_size = static_cast<std::uint32_t>(_m_nodes.size() - directories[d].first_child);
+		}
+
+		// Overlapping disks contain fewer nodes than entries.
+		if (_m_nodes.capacity() - _m_nodes.size() > _m_nodes.size() / 4) {
+			_m_nodes.shrink_to_fit();
+		}
+
+		for (auto& dir : directories) {
+			_m_nodes[dir.node]._m_children = _m_nodes.data() + dir.first_child;
+		}
+	}
+
+	VfsCompactNode const& VfsCompact::root() const noexcept {
+		return _m_nodes.front();
+	}
+
+	VfsCompactNode const* VfsCompact::resolve(std::string_view path) const noexcept {
+		auto* node = &_m_nodes.front();
+
+		while (!path.empty()) {
+			auto next = path.find('/');
+			if (next == 0) {
+				path = path.substr(next + 1);
+				continue;
+			}
+
+			auto name = trim_trailing_whitespace(path.substr(0, next));
+			if (name.empty()) return nullptr;
+
+			node = node->child(name);
+			if (node == nullptr) return nullptr;
+
+			if (next == std::string_view::npos) break;
+			path = path.substr(next + 1);
+		}
+
+		return node;
+	}
+
+	VfsOverlay::VfsOverlay() : _m_paths(std::make_unique<VfsNodeTable>()) {}
+	VfsOverlay::VfsOverlay(VfsOverlay&&) noexcept = default;
+	VfsOverlay::~VfsOverlay() noexcept = default;
+	VfsOverlay& VfsOverlay::operator=(VfsOverlay&&) noexcept = default;
+
+	std::size_t VfsOverlay::push(std::shared_ptr<Vfs const> layer, int priority) {
+		// The nodes of a layer are identified by its index, so the same Vfs can't be added twice.
+		if (_m_ranks.find(layer->_m_index.get()) != _m_ranks.end()) {
+			layer = layer->snapshot();
+		}
+
+		std::function<void(VfsNode const&)> insert = [this, &insert](VfsNode const& dir) {
+			for (auto& child : dir.children()) {
+				_m_paths->insert(child._m_path_hash, const_cast<VfsNode*>(&child));
+				if (child.type() == VfsNodeType::DIRECTORY) insert(child);
+			}
+		};
+
+		insert(layer->root());
+
+		auto it = std::upper_bound(_m_layers.begin(), _m_layers.end(), priority, [](int p, Layer const& l) {
+			return p < l.priority;
+		});
+
+		auto id = _m_next_id++;
+		_m_layers.insert(it, Layer {id, priority, std::move(layer)});
+		this->update_ranks();
+		return id;
+	}
+
+	std::size_t VfsOverlay::push_disk(std::filesystem::path const& host, int priority, MmapHint hints) {
+		auto layer = std::make_shared<Vfs>();
+		layer->mount_disk(host, VfsOverwriteBehavior::OLDER, hints);
+		return this->push(std::move(layer), priority);
+	}
+
+	std::size_t VfsOverlay::push_host(std::filesystem::path const& host, int priority) {
+		auto layer = std::make_shared<Vfs>();
+		layer->mount_host(host, "/", VfsOverwriteBehavior::ALL);
+		return this->push(std::move(layer), priority);
+	}
+
+	bool VfsOverlay::pop(std::size_t layer) {
+		auto it = std::find_if(_m_layers.begin(), _m_layers.end(), [layer](Layer const& l) { return l.id == layer; });
+		if (it == _m_layers.end()) return false;
+
+		std::function<void(VfsNode const&)> erase = [this, &erase](VfsNode const& dir) {
+			for (auto& child : dir.children()) {
+				_m_paths->erase(child._m_path_hash, &child);
+				if (child.type() == VfsNodeType::DIRECTORY) erase(child);
+			}
+		};
+
+		erase(it->vfs->root());
+		_m_layers.erase(it);
+		this->update_ranks();
+		return true;
+	}
+
+	VfsNode const* VfsOverlay::resolve(std::string_view path) const noexcept {
+		auto hash = VFS_PATH_HASH_SEED;
+		auto full = path;
+		VfsNode const* node = nullptr;
+
+		while (!path.empty()) {
+			auto next = path.find('/');
+			if (next == 0) {
+				path = path.substr(next + 1);
+				continue;
+			}
+
+			auto name = trim_trailing_whitespace(path.substr(0, next));
+			if (name.empty()) return nullptr;
+
+			// Files hide everything below them, even if another layer contains a directory at the same path.
+			if (node != nullptr && node->type() != VfsNodeType::DIRECTORY) return nullptr;
+
+			hash = vfs_path_hash(hash, name);
+			node = this->visible(hash, full.substr(0, full.size() - path.size() + name.size()));
+			if (node == nullptr) return nullptr;
+
+			if (next == std::string_view::npos) break;
+			path = path.substr(next + 1);
+		}
+
+		if (node == nullptr && !_m_layers.empty()) return &_m_layers.back().vfs->root();
+		return node;
+	}
+
+	VfsNode const* VfsOverlay::find(std::string_view name) const noexcept {
+		for (auto it = _m_layers.rbegin(); it != _m_layers.rend(); ++it) {
+			for (auto* node : it->vfs->find_all(name)) {
+				if (this->is_visible(node)) return node;
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::vector<VfsNode const*> VfsOverlay::list(std::string_view path) const {
+		auto* dir = this->resolve(path);
+		if (dir == nullptr || dir->type() != VfsNodeType::DIRECTORY) return {};
+
+		// Every path has exactly one visible node, so the listing contains no duplicates.
+		std::vector<VfsNode const*> result;
+		for (auto& layer : _m_layers) {
+			auto* node = layer.vfs->resolve(path);
+			if (node == nullptr || node->type() != VfsNodeType::DIRECTORY) continue;
+
+			for (auto& child : node->children()) {
+				if (this->visible(child._m_path_hash, &child) == &child) result.push_back(&child);
+			}
+		}
+
+		std::sort(result.begin(), result.end(), [](VfsNode const* a, VfsNode const* b) {
+			return vfs_icompare(a->name(), b->name());
+		});
+		return result;
+	}
+
+	template <typename F>
+	VfsNode const* VfsOverlay::find_visible(std::uint64_t hash, F matches) const noexcept {
+		VfsNode const* result = nullptr;
+		std::size_t best = 0;
+
+		_m_paths->each(hash, [&](VfsNode* node) {
+			if (!matches(node)) return;
+
+			auto rank = _m_ranks.find(node->_m_index)->second;
+			if (result == nullptr || rank > best) {
+				result = node;
+				best = rank;
+			}
+		});
+
+		return result;
+	}
+
+	VfsNode const* VfsOverlay::visible(std::uint64_t hash, std::string_view path) const noexcept {
+		return this->find_visible(hash, [path](VfsNode const* node) {
+			return VfsIndex::is_at_path(node, path);
+		});
+	}
+
+	VfsNode const* VfsOverlay::visible(std::uint64_t hash, VfsNode const* at) const noexcept {
+		return this->find_visible(hash, [at](VfsNode const* node) {
+			return VfsIndex::is_at_same_path(node, at);
+		});
+	}
+
+	bool VfsOverlay::is_visible(VfsNode const* node) const noexcept {
+		if (this->visible(node->_m_path_hash, node) != node) return false;
+
+		for (auto* p = node->_m_parent; p->_m_parent != nullptr; p = p->_m_parent) {
+			if (this->visible(p->_m_path_hash, p)->type() != VfsNodeType::DIRECTORY) return false;
+		}
+
+		return true;
+	}
+
+	void VfsOverlay::update_ranks() {
+		_m_ranks.clear();
+		for (std::size_t i = 0; i < _m_layers.size(); ++i) {
+			_m_ranks.emplace(_m_layers[i].vfs->_m_index.get(), i);
+		}
 	}
 } // namespace zenkit
@@ -54,15 +54,20 @@ namespace zenkit {
 	}
 
 	void World::load(Read* r, GameVersion version) {
+		this->load(r, version, WorldLoadOptions {});
+	}
+
+	void World::load(Read* r, GameVersion version, WorldLoadOptions const& options) {
 		ArchiveObject chnk {};
 		auto ar = ReadArchive::from(r);
+		ar->set_memory_resource(options.arena);
 		ar->read_object_begin(chnk);
 
 		if (chnk.class_name != "oCWorld:zCWorld") {
 			throw ParserError {"World", "'oCWorld:zCWorld' chunk expected, got '" + chnk.class_name + "'"};
 		}
 
-		this->load(*ar, version);
+		this->load(*ar, version, options);
 
 		if (!ar->read_object_end()) {
 			ZKLOGW("World", "Not fully parsed");
@@ -71,6 +76,10 @@ namespace zenkit {
 	}
 
 	void World::load(ReadArchive& r, GameVersion version) {
+		this->load(r, version, WorldLoadOptions {});
+	}
+
+	void World::load(ReadArchive& r, GameVersion version, WorldLoadOptions const& options) {
 		ArchiveObject hdr;
 
 		// Load properties of `zCWorld`
@@ -86,7 +95,16 @@ namespace zenkit {
 			       hdr.version,
 			       hdr.index);
 
-			if (hdr.object_name == "MeshAndBsp") {
+			if (hdr.object_name == "MeshAndBsp" && !options.mesh) {
+				// The mesh is stored as raw data, which can't be skipped using `skip_object`.
+				auto* raw = r.get_stream();
+				(void) /* bsp_version = */ raw->read_uint();
+				raw->seek(raw->read_uint(), Whence::CUR);
+			} else if ((hdr.object_name == "VobTree" && !options.vobs) ||
+			           (hdr.object_name == "WayNet" && !options.way_net)) {
+				r.skip_object(true);
+				continue;
+			} else if (hdr.object_name == "MeshAndBsp") {
 				auto* raw = r.get_stream();
 
 				auto bsp_version = raw->read_uint();
@@ -115,15 +133,13 @@ namespace zenkit {
 			} else if (hdr.object_name == "VobTree") {
 				auto count = r.read_int(); // childs0
 				for (auto i = 0; i < count; ++i) {
-					auto child = parse_vob_tree(r, version);
+					auto before = this->world_vobs.size();
+					parse_vob_tree(r, version, options.vob_filter, this->world_vobs);
 
 					// We failed to parse this root VObject.
-					if (child == nullptr) {
+					if (!options.vob_filter && this->world_vobs.size() == before) {
 						ZKLOGE("World", "Failed to parse root VOb %d!", i);
-						continue;
 					}
-
-					this->world_vobs.push_back(std::move(child));
 				}
 			} else if (hdr.object_name == "WayNet") {
 				this->way_net = r.read_object<WayNet>(version);
@@ -147,7 +163,25 @@ namespace zenkit {
 			}
 		}
 
-		if (r.is_save_game()) {
+		if (r.is_save_game() && !options.npcs) {
+			auto npc_count = r.read_int(); // npcCount
+			for (auto i = 0; i < npc_count; ++i) {
+				r.skip_object(false);
+			}
+
+			auto npc_spawn_count = r.read_int(); // NoOfEntries
+			for (auto i = 0; i < npc_spawn_count; ++i) {
+				r.skip_object(false);  // npc
+				(void) r.read_vec3();  // spawnPos
+				(void) r.read_float(); // timer
+			}
+
+			this->npc_spawn_enabled = r.read_bool(); // spawningEnabled
+
+			if (version == GameVersion::GOTHIC_2) {
+				this->npc_spawn_flags = r.read_int(); // spawnFlags
+			}
+		} else if (r.is_save_game()) {
 			// Then, read all the NPCs
 			auto npc_count = r.read_int(); // npcCount
 			this->npcs.resize(npc_count);
@@ -180,16 +214,13 @@ namespace zenkit {
 			Write* raw = w.get_stream();
 			raw->write_uint(version == GameVersion::GOTHIC_1 ? 0x2090000 : 0x4090000);
 
-			uint32_t size_off = raw->tell();
-			raw->write_uint(0);
+			auto size_off = raw->reserve(sizeof(uint32_t));
 
 			this->world_mesh.save(raw, version);
 			this->world_bsp_tree.save(raw, version);
 
 			auto size = static_cast<uint32_t>(raw->tell() - size_off - sizeof(uint32_t));
-			raw->seek(size_off, Whence::BEG);
-			raw->write_uint(size);
-			raw->seek(size, Whence::CUR);
+			raw->write_uint_at(size_off, size);
 
 			w.write_object_end();
 		}
@@ -5,6 +5,7 @@
 
 #include "../Internal.hh"
 
+#include <algorithm>
 #include <array>
 #include <charconv>
 #include <cstring>
@@ -26,38 +27,186 @@ namespace zenkit {
 			} catch (std::invalid_argument const& e) {
 				throw ParserError {"ReadArchive.Ascii", e, "reading int"};
 			}
+
+			this->reserve_objects(static_cast<std::size_t>(std::max(_m_objects, 0)));
 		}
 
-		if (read->read_line(true) != "END") {
+		if (read->read_line_view(true) != "END") {
 			throw ParserError {"ReadArchive.Ascii", "second END missing"};
 		}
 	}
 
-	bool ReadArchiveAscii::read_object_begin(ArchiveObject& obj) {
-		if (read->eof()) return false;
+	/// \brief Maps hexadecimal digits to their value and all other characters to `0xFF`.
+	static constexpr auto ASCII_HEX_DIGITS = [] {
+		std::array<std::uint8_t, 256> table {};
+		table.fill(0xFF);
 
-		auto mark = read->tell();
-		auto line = read->read_line(true);
+		for (std::uint8_t i = 0; i < 10; ++i) {
+			table['0' + i] = i;
+		}
 
-		// Fail quickly if we know this can't be an object begin
-		if (line.length() <= 2) {
-			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
-			return false;
+		for (std::uint8_t i = 0; i < 6; ++i) {
+			table['a' + i] = 10 + i;
+			table['A' + i] = 10 + i;
+		}
+
+		return table;
+	}();
+
+	static constexpr std::pair<std::string_view, ArchiveEntryType> ASCII_ENTRY_TYPES[] = {
+	    {"string", ArchiveEntryType::STRING},
+	    {"int", ArchiveEntryType::INTEGER},
+	    {"float", ArchiveEntryType::FLOAT},
+	    {"byte", ArchiveEntryType::BYTE},
+	    {"word", ArchiveEntryType::WORD},
+	    {"bool", ArchiveEntryType::BOOL},
+	    {"vec3", ArchiveEntryType::VEC3},
+	    {"color", ArchiveEntryType::COLOR},
+	    {"raw", ArchiveEntryType::RAW},
+	    {"rawFloat", ArchiveEntryType::RAW_FLOAT},
+	    {"enum", ArchiveEntryType::ENUM},
+	};
+
+	static bool ascii_is_space(char c) noexcept {
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+
+	static void ascii_skip_space(std::string_view& s) noexcept {
+		while (!s.empty() && ascii_is_space(s.front())) {
+			s.remove_prefix(1);
+		}
+	}
+
+	/// \brief Decode \p count bytes from pairs of hexadecimal digits.
+	///
+	/// Each pair is decoded exactly like `std::from_chars(in, in + 2, out, 16)` would, except that a pair
+	/// which does not start with a digit yields zero.
+	static void ascii_decode_hex(char const* in, std::byte* out, std::size_t count) noexcept {
+		for (std::size_t i = 0; i < count; ++i, in += 2) {
+			auto hi = ASCII_HEX_DIGITS[static_cast<std::uint8_t>(in[0])];
+			auto lo = ASCII_HEX_DIGITS[static_cast<std::uint8_t>(in[1])];
+
+			if (hi == 0xFF) {
+				out[i] = std::byte {0};
+			} else if (lo == 0xFF) {
+				out[i] = static_cast<std::byte>(hi);
+			} else {
+				out[i] = static_cast<std::byte>(hi << 4 | lo);
+			}
+		}
+	}
+
+	/// \brief Parse an integer like the given `std::sto*` function would.
+	///
+	/// Plain numbers are parsed using `std::from_chars`. Everything else, like numbers with leading whitespace
+	/// or a sign which `from_chars` does not accept, falls back to \p slow so that the result, including any
+	/// exception thrown, is exactly the same.
+	template <typename T, typename F>
+	static T ascii_parse_int(std::string_view s, F slow) {
+		T v {};
+		if (std::from_chars(s.data(), s.data() + s.size(), v).ec == std::errc {}) return v;
+		return static_cast<T>(slow(std::string {s}));
+	}
+
+	/// \brief Parse a float like `std::stof` would.
+	static float ascii_parse_float(std::string_view s) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		float v {};
+		auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+		if (ec == std::errc {} && ptr == s.data() + s.size()) return v;
+#endif
+		return std::stof(std::string {s});
+	}
+
+	/// \brief Parse whitespace-separated values like successive `std::istream::operator>>` calls would.
+	///
+	/// Parsing stops at the first value which can't be read, which is set to zero. All following values are left
+	/// unchanged.
+	template <typename T>
+	static void ascii_parse_values(std::string_view s, T* values, std::size_t count) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		for (std::size_t i = 0; i < count; ++i) {
+			ascii_skip_space(s);
+			if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+
+			auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), values[i]);
+			if (ec != std::errc {}) {
+				values[i] = 0;
+				return;
+			}
+
+			s.remove_prefix(static_cast<std::size_t>(ptr - s.data()));
 		}
+#else
+		std::stringstream in {std::string {s}};
+		for (std::size_t i = 0; i < count && in >> values[i]; ++i)
+			;
+#endif
+	}
+
+	/// \brief Parse an object header of the form `[name class version index]` like `sscanf` would.
+	static bool ascii_parse_object_header(std::string_view line, ArchiveObject& obj) {
+		if (line.empty() || line.front() != '[') return false;
+		line.remove_prefix(1);
+
+		// Like `%127s`
+		auto word = [&line]() {
+			ascii_skip_space(line);
+
+			std::size_t n = 0;
+			while (n < line.size() && n < 127 && !ascii_is_space(line[n])) {
+				++n;
+			}
+
+			auto token = line.substr(0, n);
+			line.remove_prefix(n);
+			return token;
+		};
+
+		// Like `%u`
+		auto number = [&line](unsigned long& v) {
+			ascii_skip_space(line);
+
+			bool negative = !line.empty() && line.front() == '-';
+			if (!line.empty() && (line.front() == '-' || line.front() == '+')) line.remove_prefix(1);
+
+			auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), v);
+			if (ec != std::errc {}) return false;
+
+			line.remove_prefix(static_cast<std::size_t>(ptr - line.data()));
+			if (negative) v = -v;
+			return true;
+		};
+
+		auto object_name = word();
+		if (object_name.empty()) return false;
+
+		auto class_name = word();
+		if (class_name.empty()) return false;
+
+		unsigned long version = 0;
+		unsigned long index = 0;
+		if (!number(version) || !number(index)) return false;
+
+		obj.object_name.assign(object_name);
+		obj.class_name.assign(class_name);
+		obj.version = static_cast<std::uint16_t>(version);
+		obj.index = static_cast<std::uint32_t>(index);
+		return true;
+	}
 
-		char class_name[128];
-		char object_name[128];
+	bool ReadArchiveAscii::read_object_begin(ArchiveObject& obj) {
+		if (read->eof()) return false;
 
-		auto parsed_elements =
-		    std::sscanf(line.c_str(), "[%127s %127s %hu %u]", object_name, class_name, &obj.version, &obj.index);
+		auto mark = read->tell();
+		auto line = read->read_line_view(true);
 
-		if (parsed_elements != 4) {
+		// Fail quickly if we know this can't be an object begin
+		if (line.length() <= 2 || !ascii_parse_object_header(line, obj)) {
 			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
 			return false;
 		}
 
-		obj.object_name = object_name;
-		obj.class_name = class_name;
 		return true;
 	}
 
@@ -66,18 +215,10 @@ namespace zenkit {
 		if (read->eof()) return false;
 
 		auto mark = read->tell();
-		auto line = read->read_line(true);
+		auto view = read->read_line_view(true);
 
 		// Compatibility fix for binary data in ASCII archives.
-		std::string_view view = line;
-		size_t spaces_count = 0;
-		for (; spaces_count < view.size() && std::isspace(static_cast<unsigned char>(view[spaces_count]));
-		     ++spaces_count)
-			;
-
-		if (spaces_count > 0) {
-			view.remove_prefix(spaces_count);
-		}
+		ascii_skip_space(view);
 
 		if (view != "[]") {
 			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
@@ -87,26 +228,28 @@ namespace zenkit {
 		return true;
 	}
 
-	std::string ReadArchiveAscii::read_entry(std::string_view type) {
-		auto line = read->read_line(true);
+	std::string_view ReadArchiveAscii::read_entry(std::string_view type, std::string_view alternative) {
+		auto line = read->read_line_view(true);
 		line = line.substr(line.find('=') + 1);
 		auto colon = line.find(':');
+		auto actual = line.substr(0, colon);
 
-		if (line.substr(0, colon) != type) {
+		if (actual != type && (alternative.empty() || actual != alternative)) {
 			throw ParserError {"ReadArchive.Ascii",
-			                   "type mismatch: expected " + std::string {type} + ", got: " + line.substr(0, colon)};
+			                   "type mismatch: expected " + std::string {type} +
+			                       ", got: " + std::string {actual}};
 		}
 
 		return line.substr(colon + 1);
 	}
 
 	std::string ReadArchiveAscii::read_string() {
-		return read_entry("string");
+		return std::string {read_entry("string")};
 	}
 
 	std::int32_t ReadArchiveAscii::read_int() {
 		try {
-			return std::stoi(read_entry("int"));
+			return ascii_parse_int<std::int32_t>(read_entry("int"), [](auto const& s) { return std::stoi(s); });
 		} catch (std::invalid_argument const& e) {
 			throw ParserError {"ReadArchive.Ascii", e, "reading int"};
 		}
@@ -114,7 +257,7 @@ namespace zenkit {
 
 	float ReadArchiveAscii::read_float() {
 		try {
-			return std::stof(read_entry("float"));
+			return ascii_parse_float(read_entry("float"));
 		} catch (std::invalid_argument const& e) {
 			throw ParserError {"ReadArchive.Ascii", e, "reading int"};
 		}
@@ -122,23 +265,28 @@ namespace zenkit {
 
 	std::uint8_t ReadArchiveAscii::read_byte() {
 		try {
-			return std::stoul(read_entry("int")) & 0xFF;
+			return ascii_parse_int<unsigned long>(read_entry("byte", "int"),
+			                                      [](auto const& s) { return std::stoul(s); }) &
+			    0xFF;
 		} catch (std::invalid_argument const& e) {
-			throw ParserError {"ReadArchive.Ascii", e, "reading int"};
+			throw ParserError {"ReadArchive.Ascii", e, "reading byte"};
 		}
 	}
 
 	std::uint16_t ReadArchiveAscii::read_word() {
 		try {
-			return std::stoul(read_entry("int")) & 0xFF'FF;
+			return ascii_parse_int<unsigned long>(read_entry("word", "int"),
+			                                      [](auto const& s) { return std::stoul(s); }) &
+			    0xFF'FF;
 		} catch (std::invalid_argument const& e) {
-			throw ParserError {"ReadArchive.Ascii", e, "reading int"};
+			throw ParserError {"ReadArchive.Ascii", e, "reading word"};
 		}
 	}
 
 	std::uint32_t ReadArchiveAscii::read_enum() {
 		try {
-			return std::stoul(read_entry("enum")) & 0xFFFF'FFFF;
+			return ascii_parse_int<unsigned long>(read_entry("enum"), [](auto const& s) { return std::stoul(s); }) &
+			    0xFFFF'FFFF;
 		} catch (std::invalid_argument const& e) {
 			throw ParserError {"ReadArchive.Ascii", e, "reading int"};
 		}
@@ -146,49 +294,88 @@ namespace zenkit {
 
 	bool ReadArchiveAscii::read_bool() {
 		try {
-			return std::stoul(read_entry("bool")) != 0;
+			return ascii_parse_int<unsigned long>(read_entry("bool"), [](auto const& s) { return std::stoul(s); }) !=
+			    0;
 		} catch (std::invalid_argument const& e) {
 			throw ParserError {"ReadArchive.Ascii", e, "reading int"};
 		}
 	}
 
 	Color ReadArchiveAscii::read_color() {
-		std::stringstream in {read_entry("color")};
+		std::uint16_t c[4] {};
+		ascii_parse_values(read_entry("color"), c, 4);
 
-		std::uint16_t r, g, b, a;
-		in >> r >> g >> b >> a;
-		return Color {static_cast<std::uint8_t>(r),
-		              static_cast<std::uint8_t>(g),
-		              static_cast<std::uint8_t>(b),
-		              static_cast<std::uint8_t>(a)};
+		return Color {static_cast<std::uint8_t>(c[0]),
+		              static_cast<std::uint8_t>(c[1]),
+		              static_cast<std::uint8_t>(c[2]),
+		              static_cast<std::uint8_t>(c[3])};
 	}
 
 	Vec3 ReadArchiveAscii::read_vec3() {
-		std::stringstream in {read_entry("vec3")};
-		Vec3 v {};
-
-		in >> v.x >> v.y >> v.z;
-		return v;
+		float v[3] {};
+		ascii_parse_values(read_entry("vec3"), v, 3);
+		return Vec3 {v[0], v[1], v[2]};
 	}
 
 	Vec2 ReadArchiveAscii::read_vec2() {
-		std::stringstream in {read_entry("rawFloat")};
-		Vec2 v {};
-
-		in >> v.x >> v.y;
-		return v;
+		float v[2] {};
+		ascii_parse_values(read_entry("rawFloat"), v, 2);
+		return Vec2 {v[0], v[1]};
 	}
 
 	void ReadArchiveAscii::skip_entry() {
-		(void) read->read_line(true);
+		(void) read->read_line_view(true);
 	}
 
-	AxisAlignedBoundingBox ReadArchiveAscii::read_bbox() {
-		std::stringstream in {read_entry("rawFloat")};
-		AxisAlignedBoundingBox box {};
+	bool ReadArchiveAscii::next_event(ArchiveEvent& ev, size_t& end) {
+		if (this->is_at_end()) return false;
+
+		if (read_object_begin(ev.object)) {
+			ev.type = ArchiveEventType::OBJECT_BEGIN;
+			return true;
+		}
+
+		if (read_object_end()) {
+			ev.type = ArchiveEventType::OBJECT_END;
+			return true;
+		}
+
+		auto mark = read->tell();
+		auto line = read->read_line_view(true);
+		end = read->tell();
+
+		auto eq = line.find('=');
+		auto colon = line.find(':', eq == std::string_view::npos ? 0 : eq);
+		if (eq == std::string_view::npos || colon == std::string_view::npos) {
+			throw ParserError {"ReadArchive.Ascii", "malformed entry: " + std::string {line}};
+		}
+
+		auto name = line.substr(0, eq);
+		ascii_skip_space(name);
+
+		auto type = line.substr(eq + 1, colon - eq - 1);
+		auto it = std::find_if(std::begin(ASCII_ENTRY_TYPES), std::end(ASCII_ENTRY_TYPES), [type](auto const& e) {
+			return e.first == type;
+		});
+
+		if (it == std::end(ASCII_ENTRY_TYPES)) {
+			throw ParserError {"ReadArchive.Ascii", "unknown entry type: " + std::string {type}};
+		}
 
-		in >> box.min.x >> box.min.y >> box.min.z >> box.max.x >> box.max.y >> box.max.z;
-		return box;
+		ev.type = ArchiveEventType::ENTRY;
+		ev.entry = it->second;
+		ev.name.assign(name);
+		ev.size = line.size() - colon - 1;
+		if (ev.entry == ArchiveEntryType::RAW) ev.size /= 2;
+
+		read->seek(static_cast<ssize_t>(mark), Whence::BEG);
+		return true;
+	}
+
+	AxisAlignedBoundingBox ReadArchiveAscii::read_bbox() {
+		float v[6] {};
+		ascii_parse_values(read_entry("rawFloat"), v, 6);
+		return AxisAlignedBoundingBox {Vec3 {v[0], v[1], v[2]}, Vec3 {v[3], v[4], v[5]}};
 	}
 
 	Mat3 ReadArchiveAscii::read_mat3x3() {
@@ -198,18 +385,12 @@ namespace zenkit {
 			throw ParserError {"ReadArchive.Ascii", "raw entry does not contain enough bytes to be a 3x3 matrix"};
 		}
 
-		auto beg_it = in.data();
+		std::byte bytes[sizeof(float) * 9];
+		ascii_decode_hex(in.data(), bytes, sizeof bytes);
 
 		Mat3 v {};
 		for (int32_t i = 0; i < 9; ++i) {
-			std::uint8_t tmp[4];
-			std::from_chars(beg_it + 0, beg_it + 2, tmp[0], 16);
-			std::from_chars(beg_it + 2, beg_it + 4, tmp[1], 16);
-			std::from_chars(beg_it + 4, beg_it + 6, tmp[2], 16);
-			std::from_chars(beg_it + 6, beg_it + 8, tmp[3], 16);
-			beg_it += 8;
-
-			memcpy(&v[i / 3][i % 3], tmp, sizeof(float));
+			memcpy(&v[i / 3][i % 3], bytes + i * sizeof(float), sizeof(float));
 		}
 
 		return v.transpose();
@@ -227,17 +408,30 @@ namespace zenkit {
 			ZKLOGW("ReadArchive.Ascii", "Reading %zu bytes although %zu are actually available", size, length);
 		}
 
-		std::vector<std::byte> out {};
-		out.resize(length);
+		std::vector<std::byte> out(length);
+		ascii_decode_hex(in.data(), out.data(), length);
+		return Read::from(std::move(out));
+	}
 
-		auto beg_it = in.data();
+	std::vector<float> ReadArchiveAscii::read_raw_float() {
+		auto in = read_entry("rawFloat");
+		std::vector<float> values;
 
-		for (std::byte& i : out) {
-			std::from_chars(beg_it + 0, beg_it + 2, reinterpret_cast<std::uint8_t&>(i), 16);
-			beg_it += 2;
+		try {
+			for (ascii_skip_space(in); !in.empty(); ascii_skip_space(in)) {
+				size_t n = 0;
+				while (n < in.size() && !ascii_is_space(in[n])) {
+					++n;
+				}
+
+				values.push_back(ascii_parse_float(in.substr(0, n)));
+				in.remove_prefix(n);
+			}
+		} catch (std::invalid_argument const& e) {
+			throw ParserError {"ReadArchive.Ascii", e, "reading float"};
 		}
 
-		return Read::from(std::move(out));
+		return values;
 	}
 
 	WriteArchiveAscii::WriteArchiveAscii(Write* w) : _m_write(w) {
@@ -372,17 +566,11 @@ namespace zenkit {
 		this->_m_write->write_string(name);
 		this->_m_write->write_string("=raw:");
 
-		std::array<char, 3> buf {};
-		buf[2] = '\0';
+		static constexpr char HEX[] = "0123456789abcdef";
 		for (auto i = 0u; i < length; ++i) {
-			std::to_chars(buf.data(), buf.data() + buf.size(), static_cast<unsigned char>(v[i]), 16);
-
-			if (buf[1] == '\0') {
-				this->_m_write->write_char('0');
-				this->_m_write->write_char(buf[0]);
-			} else {
-				this->_m_write->write_string(buf.data());
-			}
+			auto b = static_cast<unsigned char>(v[i]);
+			this->_m_write->write_char(HEX[b >> 4]);
+			this->_m_write->write_char(HEX[b & 0xF]);
 		}
 
 		this->_m_write->write_char('\n');
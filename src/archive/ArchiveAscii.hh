@@ -28,12 +28,14 @@ namespace zenkit {
 		AxisAlignedBoundingBox read_bbox() override;
 		Mat3 read_mat3x3() override;
 		std::unique_ptr<Read> read_raw(std::size_t size) override;
+		std::vector<float> read_raw_float() override;
 
 	protected:
 		void read_header() override;
 		void skip_entry() override;
+		bool next_event(ArchiveEvent& ev, size_t& end) override;
 
-		std::string read_entry(std::string_view type);
+		std::string_view read_entry(std::string_view type, std::string_view alternative = {});
 
 	private:
 		int32_t _m_objects {0};
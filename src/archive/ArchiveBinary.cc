@@ -3,6 +3,7 @@
 #include "ArchiveBinary.hh"
 #include "zenkit/Error.hh"
 
+#include <algorithm>
 #include <charconv>
 #include <cstring>
 #include <stdexcept>
@@ -20,6 +21,8 @@ namespace zenkit {
 			} catch (std::invalid_argument const& e) {
 				throw ParserError {"ReadArchiveBinary", e, "reading int"};
 			}
+
+			this->reserve_objects(static_cast<std::size_t>(std::max(_m_objects, 0)));
 		}
 
 		if (read->read_line_then_ignore("\n") != "END") {
@@ -35,12 +38,15 @@ namespace zenkit {
 
 		obj.version = read->read_ushort();
 		obj.index = read->read_uint();
-		obj.object_name = read->read_line(false);
-		obj.class_name = read->read_line(false);
+		obj.object_name = read->read_line_view(false);
+		obj.class_name = read->read_line_view(false);
 		return true;
 	}
 
 	bool ReadArchiveBinary::read_object_end() {
+		// After seek_object, the ends of the enclosing objects are unknown.
+		if (_m_object_end.empty()) return read->eof();
+
 		if (read->tell() == _m_object_end.top()) {
 			_m_object_end.pop();
 			return true;
@@ -110,12 +116,20 @@ namespace zenkit {
 		return Read::from(std::move(bytes));
 	}
 
+	std::vector<float> ReadArchiveBinary::read_raw_float() {
+		throw ParserError {"ReadArchive.Binary", "cannot read raw floats of unknown length in binary archive"};
+	}
+
 	void ReadArchiveBinary::skip_entry() {
 		throw ParserError {"archive_reader", "cannot skip entry in binary archive"};
 	}
 
 	void ReadArchiveBinary::skip_object(bool skip_current) {
 		if (skip_current) {
+			if (_m_object_end.empty()) {
+				throw ParserError {"ReadArchive.Binary", "cannot skip the current object: not inside an object"};
+			}
+
 			read->seek(static_cast<ssize_t>(_m_object_end.top()), Whence::BEG);
 			_m_object_end.pop();
 		} else {
@@ -123,6 +137,122 @@ namespace zenkit {
 		}
 	}
 
+	void ReadArchiveBinary::seek_object(ArchiveObjectLocation const& loc) {
+		ReadArchive::seek_object(loc);
+		_m_object_end = {};
+	}
+
+	void ReadArchiveBinary::scan_objects(std::vector<ArchiveObjectLocation>& out) {
+		(void) this->scan_objects(out, this->get_level_end(), 0);
+	}
+
+	/// Scans the objects stored back to back from the current position up to \p end. Returns `false`, if the data
+	/// does not consist of objects only, leaving all objects scanned successfully in \p out.
+	bool ReadArchiveBinary::scan_objects(std::vector<ArchiveObjectLocation>& out, size_t end, uint32_t depth) {
+		while (read->tell() < end) {
+			auto offset = read->tell();
+			size_t object_end = 0;
+
+			ArchiveObject obj;
+			if (!this->scan_object_header(obj, end, object_end)) return false;
+
+			auto first = out.size();
+			out.push_back(ArchiveObjectLocation {offset, depth, std::move(obj)});
+
+			// Objects which contain anything but other objects can't be scanned any further.
+			if (!this->scan_objects(out, object_end, depth + 1)) {
+				out.resize(first + 1);
+			}
+
+			read->seek(static_cast<ssize_t>(object_end), Whence::BEG);
+		}
+
+		return true;
+	}
+
+	/// Reads the header of the object at the current position. Returns `false` if it is not a valid object header
+	/// or if the object does not end before \p end.
+	bool ReadArchiveBinary::scan_object_header(ArchiveObject& obj, size_t end, size_t& object_end) {
+		// Size, version, index and two NUL-terminated strings.
+		static constexpr size_t MIN_OBJECT_SIZE = 4 + 2 + 4 + 2;
+
+		auto offset = read->tell();
+		if (end - offset < MIN_OBJECT_SIZE) return false;
+
+		auto size = read->read_uint();
+		if (size < MIN_OBJECT_SIZE || size > end - offset) return false;
+
+		obj.version = read->read_ushort();
+		obj.index = read->read_uint();
+		obj.object_name = read->read_line_view(false);
+		obj.class_name = read->read_line_view(false);
+
+		object_end = offset + size;
+		return read->tell() <= object_end;
+	}
+
+	/// Checks whether the data from the current position up to \p end consists of objects only. The stream position
+	/// is restored afterwards.
+	bool ReadArchiveBinary::is_object_sequence(size_t end) {
+		auto mark = read->tell();
+		auto sequence = true;
+
+		ArchiveObject obj;
+		while (sequence && read->tell() < end) {
+			size_t object_end = 0;
+			sequence = this->scan_object_header(obj, end, object_end);
+			read->seek(static_cast<ssize_t>(object_end), Whence::BEG);
+		}
+
+		read->seek(static_cast<ssize_t>(mark), Whence::BEG);
+		return sequence;
+	}
+
+	size_t ReadArchiveBinary::get_level_end() {
+		if (!_m_object_end.empty()) return _m_object_end.top();
+
+		auto mark = read->tell();
+		read->seek(0, Whence::END);
+		auto end = read->tell();
+		read->seek(static_cast<ssize_t>(mark), Whence::BEG);
+		return end;
+	}
+
+	bool ReadArchiveBinary::next_event(ArchiveEvent& ev, size_t& end) {
+		if (!_m_object_end.empty() && read->tell() >= _m_object_end.top()) {
+			read->seek(static_cast<ssize_t>(_m_object_end.top()), Whence::BEG);
+			_m_object_end.pop();
+			ev.type = ArchiveEventType::OBJECT_END;
+			return true;
+		}
+
+		if (read->eof()) return false;
+
+		// Remember, for every level of nesting, whether it consists of objects only. Each level is identified by
+		// its end, so that objects begun or ended outside of `read_event` are accounted for.
+		auto level_end = this->get_level_end();
+		auto depth = _m_object_end.size();
+		_m_event_sequences.resize(depth + 1, {SIZE_MAX, false});
+
+		auto& level = _m_event_sequences[depth];
+		if (level.first != level_end) {
+			level = {level_end, this->is_object_sequence(level_end)};
+		}
+
+		if (level.second) {
+			(void) this->read_object_begin(ev.object);
+			ev.type = ArchiveEventType::OBJECT_BEGIN;
+			return true;
+		}
+
+		ev.type = ArchiveEventType::ENTRY;
+		ev.entry = ArchiveEntryType::RAW;
+		ev.name.clear();
+		ev.size = level_end - read->tell();
+		end = level_end;
+		return true;
+	}
+
 	WriteArchiveBinary::WriteArchiveBinary(Write* w) : _m_write(w) {
 		this->_m_head = this->_m_write->tell();
 		this->write_header();
@@ -149,24 +279,16 @@ namespace zenkit {
 		auto prev = this->_m_objects.top();
 		this->_m_objects.pop();
 
-		this->_m_write->seek(static_cast<ssize_t>(prev), Whence::BEG);
-		this->_m_write->write_uint(static_cast<uint32_t>(cur - prev));
-		this->_m_write->seek(static_cast<ssize_t>(cur), Whence::BEG);
+		this->_m_write->write_uint_at(prev, static_cast<uint32_t>(cur - prev));
 	}
 
 	void WriteArchiveBinary::write_ref(std::string_view object_name, uint32_t index) {
-		auto start = this->_m_write->tell();
-
-		this->_m_write->write_uint(static_cast<uint32_t>(6 + object_name.length() + 1 + 2));
+		// size (4) + version (2) + index (4) + object name + NUL + class name ("\xA7") + NUL
+		this->_m_write->write_uint(static_cast<uint32_t>(4 + 2 + 4 + object_name.length() + 1 + 2));
 		this->_m_write->write_ushort(0);
 		this->_m_write->write_uint(index);
 		this->_m_write->write_string0(object_name);
 		this->_m_write->write_string0("\xA7");
-
-		auto cur = this->_m_write->tell();
-		this->_m_write->seek(static_cast<ssize_t>(start), Whence::BEG);
-		this->_m_write->write_uint(static_cast<uint32_t>(cur - start));
-		this->_m_write->seek(static_cast<ssize_t>(cur), Whence::BEG);
 	}
 
 	void WriteArchiveBinary::write_string(std::string_view, std::string_view v) {
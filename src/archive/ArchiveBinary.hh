@@ -5,6 +5,8 @@
 #include "zenkit/Stream.hh"
 
 #include <stack>
+#include <utility>
+#include <vector>
 
 namespace zenkit {
 	class ReadArchiveBinary final : public ReadArchive {
@@ -30,15 +32,29 @@ namespace zenkit {
 		AxisAlignedBoundingBox read_bbox() override;
 		Mat3 read_mat3x3() override;
 		std::unique_ptr<Read> read_raw(std::size_t size) override;
+		std::vector<float> read_raw_float() override;
 
 		void skip_object(bool skip_current) override;
+		void seek_object(ArchiveObjectLocation const& loc) override;
+
+		[[nodiscard]] std::uint32_t get_object_count() const noexcept {
+			return static_cast<std::uint32_t>(_m_objects);
+		}
 
 	protected:
 		void read_header() override;
 		void skip_entry() override;
+		void scan_objects(std::vector<ArchiveObjectLocation>& out) override;
+		bool next_event(ArchiveEvent& ev, size_t& end) override;
 
 	private:
+		bool scan_objects(std::vector<ArchiveObjectLocation>& out, size_t end, uint32_t depth);
+		bool scan_object_header(ArchiveObject& obj, size_t end, size_t& object_end);
+		bool is_object_sequence(size_t end);
+		size_t get_level_end();
+
 		std::stack<uint64_t> _m_object_end {};
+		std::vector<std::pair<size_t, bool>> _m_event_sequences {};
 		int32_t _m_objects {0};
 	};
 
@@ -72,6 +88,12 @@ namespace zenkit {
 			return _m_write;
 		}
 
+		/// \brief Set the number of objects written to the header for objects not written using
+		///        write_object_begin, like those copied from another archive verbatim.
+		void set_object_count(std::uint32_t count) noexcept {
+			_m_index = count;
+		}
+
 	private:
 		Write* _m_write;
 		std::uint32_t _m_index {0};
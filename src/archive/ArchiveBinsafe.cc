@@ -6,16 +6,21 @@
 #include "../Internal.hh"
 
 #include <algorithm>
+#include <cctype>
 #include <charconv>
 #include <cstring>
+#include <limits>
 
 namespace zenkit {
 	void ReadArchiveBinsafe::read_header() {
 		_m_bs_version = read->read_uint();
 		_m_object_count = read->read_uint();
+		this->reserve_objects(_m_object_count);
 
 		{
 			auto hash_table_offset = read->read_uint();
+			_m_hash_table_offset = hash_table_offset;
+
 			auto mark = read->tell();
 			read->seek(hash_table_offset, Whence::BEG);
 
@@ -26,52 +31,97 @@ namespace zenkit {
 				auto key_length = read->read_ushort();
 				auto insertion_index = read->read_ushort();
 				auto hash_value = read->read_uint();
-				auto key = read->read_string(key_length);
+				auto key = read->read_string_view(key_length);
 
-				_m_hash_table_entries[insertion_index] = hash_table_entry {key, hash_value};
+				_m_hash_table_entries[insertion_index] = hash_table_entry {std::string {key}, hash_value};
 			}
 
 			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
 		}
 	}
 
-	bool ReadArchiveBinsafe::read_object_begin(ArchiveObject& obj) {
-		if (read->eof()) return false;
+	/// \brief The parts of an object header of the form `[name class version index]`.
+	struct BinsafeObjectHeader {
+		std::string_view object_name;
+		std::string_view class_name;
+		std::uint16_t version;
+		std::uint32_t index;
+	};
 
-		auto mark = read->tell();
-		if (static_cast<ArchiveEntryType>(read->read_ubyte()) != ArchiveEntryType::STRING) {
-			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
-			return false;
-		}
+	/// \brief Parse an object header from the given line without allocating.
+	///
+	/// Tokens are separated by any number of spaces or closing brackets. Numbers are parsed like `atoi` would,
+	/// i.e. trailing garbage is ignored and unparsable numbers are read as zero.
+	static bool bs_parse_object_header(std::string_view line, BinsafeObjectHeader& header) noexcept {
+		// Fail quickly if we know this can't be an object begin
+		if (line.length() <= 2 || line.front() != '[') return false;
+		line.remove_prefix(1);
+
+		auto next_token = [&line]() {
+			auto begin = line.find_first_not_of(" ]");
+			if (begin == std::string_view::npos) return line = {};
+
+			line.remove_prefix(begin);
+			auto end = line.find_first_of(" ]");
+			auto token = line.substr(0, end);
+			line.remove_prefix(end == std::string_view::npos ? line.size() : end + 1);
+			return token;
+		};
+
+		// Like glibc's `atoi`, which is `(int) strtol(...)`: skip leading whitespace and a plus sign, clamp
+		// to the range of a 64-bit integer and truncate the result.
+		auto parse_int = [](std::string_view token) {
+			while (!token.empty() && std::isspace(static_cast<unsigned char>(token.front()))) {
+				token.remove_prefix(1);
+			}
 
-		auto line = read->read_string(read->read_ushort());
+			if (token.starts_with('+') && !token.substr(1).starts_with('-')) {
+				token.remove_prefix(1);
+			}
 
-		// Fail quickly if we know this can't be an object begin
-		if (line.length() <= 2) {
-			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
+			std::int64_t v = 0;
+			auto result = std::from_chars(token.data(), token.data() + token.size(), v);
+			if (result.ec == std::errc::result_out_of_range) {
+				v = token.starts_with('-') ? std::numeric_limits<std::int64_t>::min()
+				                           : std::numeric_limits<std::int64_t>::max();
+			}
+
+			return static_cast<std::int32_t>(v);
+		};
+
+		header.object_name = next_token();
+		header.class_name = next_token();
+		auto version = next_token();
+		auto index = next_token();
+
+		if (header.object_name.empty() || header.class_name.empty() || version.empty() || index.empty()) {
 			return false;
 		}
 
-		char* it = line.data();
-		if (*it++ != '[') {
+		header.version = static_cast<std::uint16_t>(parse_int(version));
+		header.index = static_cast<std::uint32_t>(parse_int(index));
+		return true;
+	}
+
+	bool ReadArchiveBinsafe::read_object_begin(ArchiveObject& obj) {
+		if (read->eof()) return false;
+
+		auto mark = read->tell();
+		if (static_cast<ArchiveEntryType>(read->read_ubyte()) != ArchiveEntryType::STRING) {
 			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
 			return false;
 		}
 
-		auto* object_name = strtok(it, " ]");
-		auto* class_name = strtok(nullptr, " ]");
-		auto* version = strtok(nullptr, " ]");
-		auto* index = strtok(nullptr, " ]");
-
-		if (object_name == nullptr || class_name == nullptr || version == nullptr || index == nullptr) {
+		BinsafeObjectHeader header;
+		if (!bs_parse_object_header(read->read_string_view(read->read_ushort()), header)) {
 			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
 			return false;
 		}
 
-		obj.version = static_cast<uint16_t>(atoi(version));
-		obj.index = static_cast<uint32_t>(atoi(index));
-		obj.object_name = object_name;
-		obj.class_name = class_name;
+		obj.version = header.version;
+		obj.index = header.index;
+		obj.object_name.assign(header.object_name);
+		obj.class_name.assign(header.class_name);
 		return true;
 	}
 
@@ -89,7 +139,7 @@ namespace zenkit {
 			return false;
 		}
 
-		if (read->read_string(2) != "[]") {
+		if (read->read_string_view(2) != "[]") {
 			read->seek(static_cast<ssize_t>(mark), Whence::BEG);
 			return false;
 		}
@@ -97,12 +147,97 @@ namespace zenkit {
 		return true;
 	}
 
+	void ReadArchiveBinsafe::skip_object(bool skip_current) {
+		BinsafeObjectHeader header;
+		int32_t level = skip_current ? 1 : 0;
+
+		// Classify each entry by looking at it only once, instead of trying to read it as an object begin,
+		// an object end and a plain entry one after the other.
+		do {
+			if (read->eof()) {
+				--level;
+				continue;
+			}
+
+			auto mark = read->tell();
+			if (static_cast<ArchiveEntryType>(read->read_ubyte()) != ArchiveEntryType::STRING) {
+				read->seek(static_cast<ssize_t>(mark), Whence::BEG);
+				this->skip_entry();
+				continue;
+			}
+
+			auto line = read->read_string_view(read->read_ushort());
+			if (line == "[]") {
+				--level;
+			} else if (bs_parse_object_header(line, header)) {
+				++level;
+			}
+		} while (level > 0);
+	}
+
+	bool ReadArchiveBinsafe::next_event(ArchiveEvent& ev, size_t& end) {
+		if (this->is_at_end()) return false;
+
+		if (read_object_begin(ev.object)) {
+			ev.type = ArchiveEventType::OBJECT_BEGIN;
+			return true;
+		}
+
+		if (read_object_end()) {
+			ev.type = ArchiveEventType::OBJECT_END;
+			return true;
+		}
+
+		auto mark = read->tell();
+		auto& key = this->get_entry_key();
+		auto type = static_cast<ArchiveEntryType>(read->read_ubyte());
+
+		switch (type) {
+		case ArchiveEntryType::STRING:
+		case ArchiveEntryType::RAW:
+		case ArchiveEntryType::RAW_FLOAT:
+			ev.size = read->read_ushort();
+			break;
+		case ArchiveEntryType::INTEGER:
+		case ArchiveEntryType::FLOAT:
+		case ArchiveEntryType::BYTE:
+		case ArchiveEntryType::WORD:
+		case ArchiveEntryType::BOOL:
+		case ArchiveEntryType::VEC3:
+		case ArchiveEntryType::COLOR:
+		case ArchiveEntryType::ENUM:
+		case ArchiveEntryType::HASH:
+			ev.size = type_sizes[static_cast<uint8_t>(type)];
+			break;
+		default:
+			throw ParserError {"ReadArchive.Binsafe",
+			                   "unknown entry type: " + std::to_string(static_cast<uint32_t>(type))};
+		}
+
+		ev.type = ArchiveEventType::ENTRY;
+		ev.entry = type;
+		ev.name = key;
+		end = read->tell() + ev.size;
+
+		read->seek(static_cast<ssize_t>(mark), Whence::BEG);
+		return true;
+	}
+
+	bool ReadArchiveBinsafe::is_at_end() const noexcept {
+		// The hash table is stored after all objects.
+		return read->eof() || read->tell() >= _m_hash_table_offset;
+	}
+
 	std::string const& ReadArchiveBinsafe::get_entry_key() {
 		if (static_cast<ArchiveEntryType>(read->read_ubyte()) != ArchiveEntryType::HASH) {
 			throw ParserError {"ReadArchive.Binsafe", "invalid format"};
 		}
 
 		auto hash = read->read_uint();
+		if (hash >= _m_hash_table_entries.size()) {
+			throw ParserError {"ReadArchive.Binsafe", "invalid entry key: " + std::to_string(hash)};
+		}
+
 		return _m_hash_table_entries[hash].key;
 	}
 
@@ -218,6 +353,17 @@ namespace zenkit {
 		return Read::from(std::move(bytes));
 	}
 
+	std::vector<float> ReadArchiveBinsafe::read_raw_float() {
+		auto size = ensure_entry_meta<ArchiveEntryType::RAW_FLOAT>();
+
+		std::vector<float> values(size / sizeof(float));
+		read->read_array(std::span {values});
+
+		// There might be more bytes in this. We'll ignore them.
+		read->seek(size % sizeof(float), Whence::CUR);
+		return values;
+	}
+
 	void ReadArchiveBinsafe::skip_entry() {
 		switch (static_cast<ArchiveEntryType>(read->read_ubyte())) {
 		case ArchiveEntryType::STRING:
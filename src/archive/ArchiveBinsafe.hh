@@ -58,10 +58,15 @@ namespace zenkit {
 		AxisAlignedBoundingBox read_bbox() override;
 		Mat3 read_mat3x3() override;
 		std::unique_ptr<Read> read_raw(std::size_t size) override;
+		std::vector<float> read_raw_float() override;
+
+		void skip_object(bool skip_current) override;
 
 	protected:
 		void read_header() override;
 		void skip_entry() override;
+		bool next_event(ArchiveEvent& ev, size_t& end) override;
+		[[nodiscard]] bool is_at_end() const noexcept override;
 
 		std::string const& get_entry_key();
 
@@ -71,6 +76,7 @@ namespace zenkit {
 	private:
 		std::uint32_t _m_object_count {0};
 		std::uint32_t _m_bs_version {0};
+		std::uint32_t _m_hash_table_offset {0};
 
 		std::vector<hash_table_entry> _m_hash_table_entries;
 	};
@@ -83,10 +83,7 @@ namespace zenkit {
 				break;
 			case BspChunkType::POLYGONS:
 				this->polygon_indices.resize(c->read_uint());
-
-				for (uint32_t& index : this->polygon_indices) {
-					index = c->read_uint();
-				}
+				c->read_array<uint32_t>(this->polygon_indices);
 				break;
 			case BspChunkType::TREE: {
 				uint32_t node_count = c->read_uint();
@@ -109,9 +106,7 @@ namespace zenkit {
 			}
 			case BspChunkType::LIGHT: {
 				this->light_points.resize(this->leaf_node_indices.size());
-				for (auto& light_point : this->light_points) {
-					light_point = c->read_vec3();
-				}
+				c->read_array<Vec3>(this->light_points);
 				break;
 			}
 			case BspChunkType::OUTDOORS: {
@@ -121,7 +116,7 @@ namespace zenkit {
 				for (std::uint32_t i = 0; i < sector_count; ++i) {
 					auto& sector = this->sectors.emplace_back();
 
-					sector.name = c->read_line(false);
+					sector.name = c->read_line_view(false);
 
 					auto node_count = c->read_uint();
 					auto polygon_count = c->read_uint();
@@ -129,13 +124,8 @@ namespace zenkit {
 					sector.node_indices.resize(node_count);
 					sector.portal_polygon_indices.resize(polygon_count);
 
-					for (std::uint32_t j = 0; j < node_count; ++j) {
-						sector.node_indices[j] = c->read_uint();
-					}
-
-					for (std::uint32_t j = 0; j < polygon_count; ++j) {
-						sector.portal_polygon_indices[j] = c->read_uint();
-					}
+					c->read_array<uint32_t>(sector.node_indices);
+					c->read_array<uint32_t>(sector.portal_polygon_indices);
 				}
 
 				auto portal_count = c->read_uint();
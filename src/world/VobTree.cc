@@ -5,8 +5,31 @@
 #include "zenkit/vobs/VirtualObject.hh"
 
 namespace zenkit {
+	static void skip_vob_tree(ReadArchive& in, size_t count) {
+		for (auto i = 0u; i < count; ++i) {
+			in.skip_object(false);
+
+			auto num_children = static_cast<size_t>(in.read_int());
+			skip_vob_tree(in, num_children);
+		}
+	}
+
 	std::shared_ptr<VirtualObject> parse_vob_tree(ReadArchive& in, GameVersion version) {
-		auto obj = in.read_object(version);
+		std::vector<std::shared_ptr<VirtualObject>> out;
+		parse_vob_tree(in, version, nullptr, out);
+		return out.empty() ? nullptr : std::move(out.front());
+	}
+
+	void parse_vob_tree(ReadArchive& in,
+	                    GameVersion version,
+	                    VobFilter const& filter,
+	                    std::vector<std::shared_ptr<VirtualObject>>& out) {
+		auto action = VobFilterAction::LOAD;
+		auto obj = in.read_object(version, [&filter, &action](ArchiveObject const& hdr, ObjectType type) {
+			if (filter) action = filter(hdr, type);
+			return action == VobFilterAction::LOAD;
+		});
+
 		if (obj != nullptr && !is_vobject(obj->get_object_type())) {
 			obj = nullptr;
 		}
@@ -15,31 +38,22 @@ namespace zenkit {
 		std::shared_ptr<VirtualObject> object {obj, reinterpret_cast<VirtualObject*>(obj.get())};
 
 		auto child_count = static_cast<size_t>(in.read_int());
-		if (object == nullptr) {
-			std::function<void(size_t)> skip;
-			skip = [&skip, &in](size_t count) {
-				for (auto i = 0u; i < count; ++i) {
-					in.skip_object(false);
-
-					auto num_children = static_cast<size_t>(in.read_int());
-					skip(num_children);
-				}
-			};
-
-			skip(child_count);
-			return nullptr;
+		if (object == nullptr && action != VobFilterAction::SKIP) {
+			skip_vob_tree(in, child_count);
+			return;
 		}
 
-		object->children.reserve(child_count);
+		// Children of skipped VObs are attached to the closest loaded ancestor instead.
+		auto& children = object == nullptr ? out : object->children;
+		if (object != nullptr) children.reserve(child_count);
 
 		for (auto i = 0u; i < child_count; ++i) {
-			auto child = parse_vob_tree(in, version);
-			if (child == nullptr) continue;
-
-			object->children.push_back(std::move(child));
+			parse_vob_tree(in, version, filter, children);
 		}
 
-		return object;
+		if (object != nullptr) {
+			out.push_back(std::move(object));
+		}
 	}
 
 	static void
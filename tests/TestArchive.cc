@@ -3,9 +3,86 @@
 #include <zenkit/Archive.hh>
 #include <zenkit/Error.hh>
 #include <zenkit/Stream.hh>
+#include <zenkit/world/WayNet.hh>
 
 #include <doctest/doctest.h>
 
+/// \brief An event of an archive along with the value of its entry for comparing archives.
+struct ArchiveEntry {
+	zenkit::ArchiveEventType type;
+	zenkit::ArchiveEntryType entry;
+	std::string name;
+	std::string value;
+	std::vector<float> floats;
+};
+
+static std::vector<ArchiveEntry> read_entries(zenkit::Read* in) {
+	auto reader = zenkit::ReadArchive::from(in);
+
+	std::vector<ArchiveEntry> entries;
+	zenkit::ArchiveEvent ev;
+
+	while (reader->read_event(ev)) {
+		if (ev.type == zenkit::ArchiveEventType::ENTRY && ev.entry == zenkit::ArchiveEntryType::HASH) continue;
+
+		auto& e = entries.emplace_back(ArchiveEntry {ev.type, ev.entry, ev.name, {}, {}});
+		if (ev.type == zenkit::ArchiveEventType::OBJECT_BEGIN) {
+			e.value = ev.object.object_name + " " + ev.object.class_name + " " + std::to_string(ev.object.version);
+			continue;
+		}
+
+		if (ev.type != zenkit::ArchiveEventType::ENTRY) continue;
+
+		switch (ev.entry) {
+		case zenkit::ArchiveEntryType::STRING:
+			e.value = reader->read_string();
+			break;
+		case zenkit::ArchiveEntryType::INTEGER:
+			e.value = std::to_string(reader->read_int());
+			break;
+		case zenkit::ArchiveEntryType::BYTE:
+			e.value = std::to_string(reader->read_byte());
+			break;
+		case zenkit::ArchiveEntryType::WORD:
+			e.value = std::to_string(reader->read_word());
+			break;
+		case zenkit::ArchiveEntryType::ENUM:
+			e.value = std::to_string(reader->read_enum());
+			break;
+		case zenkit::ArchiveEntryType::BOOL:
+			e.value = std::to_string(reader->read_bool());
+			break;
+		case zenkit::ArchiveEntryType::COLOR: {
+			auto c = reader->read_color();
+			e.value = std::to_string(c.r) + " " + std::to_string(c.g) + " " + std::to_string(c.b) + " " +
+			    std::to_string(c.a);
+			break;
+		}
+		case zenkit::ArchiveEntryType::FLOAT:
+			e.floats = {reader->read_float()};
+			break;
+		case zenkit::ArchiveEntryType::VEC3: {
+			auto v = reader->read_vec3();
+			e.floats = {v.x, v.y, v.z};
+			break;
+		}
+		case zenkit::ArchiveEntryType::RAW_FLOAT:
+			e.floats = reader->read_raw_float();
+			break;
+		case zenkit::ArchiveEntryType::RAW: {
+			auto raw = reader->read_raw(ev.size);
+			e.value.resize(ev.size);
+			e.value.resize(raw->read(e.value.data(), e.value.size()));
+			break;
+		}
+		case zenkit::ArchiveEntryType::HASH:
+			break;
+		}
+	}
+
+	return entries;
+}
+
 TEST_SUITE("ReadArchive") {
 	TEST_CASE("ReadArchive.from(ASCII)") {
 		zenkit::Logger::set_default(zenkit::LogLevel::DEBUG);
@@ -91,6 +168,104 @@ TEST_SUITE("ReadArchive") {
 		REQUIRE_THROWS_AS(reader->read_float(), zenkit::ParserError);
 	}
 
+	TEST_CASE("ReadArchive.from(ASCII,edge)") {
+		std::string_view data = "ZenGin Archive\nver 1\nzCArchiverGeneric\nASCII\nsaveGame 0\n"
+		                        "date 01.01.2001 00:00:00\nuser luis\nEND\nobjects 1\nEND\n\n"
+		                        "[  obj   cls:a  -1 \t7]\n"
+		                        "\ti0=int: 12\n"
+		                        "\ti1=int:+7abc\n"
+		                        "\ti2=int:-2147483648\n"
+		                        "\tb0=int:-1\n"
+		                        "\tw0=int:65537\n"
+		                        "\tf0=float:1.5e2\n"
+		                        "\tf1=float:-0.25x\n"
+		                        "\tv0=vec3:1 +2\n"
+		                        "\tv1=rawFloat:3.5 abc\n"
+		                        "\tc0=color:10 20 30 40\n"
+		                        "\tr0=raw:aBFf0g\n"
+		                        "\ts0=int:1\n"
+		                        "\ti3=int:abc\n"
+		                        "[]\n";
+
+		auto in = zenkit::Read::from(reinterpret_cast<std::byte const*>(data.data()), data.size());
+		auto reader = zenkit::ReadArchive::from(in.get());
+
+		zenkit::ArchiveObject obj;
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(obj.object_name, "obj");
+		CHECK_EQ(obj.class_name, "cls:a");
+		CHECK_EQ(obj.version, 0xFFFF);
+		CHECK_EQ(obj.index, 7);
+
+		CHECK_EQ(reader->read_int(), 12);
+		CHECK_EQ(reader->read_int(), 7);
+		CHECK_EQ(reader->read_int(), -2147483647 - 1);
+		CHECK_EQ(reader->read_byte(), 0xFF);
+		CHECK_EQ(reader->read_word(), 1);
+		CHECK_EQ(reader->read_float(), 150.0f);
+		CHECK_EQ(reader->read_float(), -0.25f);
+
+		auto v3 = reader->read_vec3();
+		CHECK_EQ(v3.x, 1.0f);
+		CHECK_EQ(v3.y, 2.0f);
+		CHECK_EQ(v3.z, 0.0f);
+
+		auto v2 = reader->read_vec2();
+		CHECK_EQ(v2.x, 3.5f);
+		CHECK_EQ(v2.y, 0.0f);
+
+		auto color = reader->read_color();
+		CHECK_EQ(color.r, 10);
+		CHECK_EQ(color.g, 20);
+		CHECK_EQ(color.b, 30);
+		CHECK_EQ(color.a, 40);
+
+		auto raw = reader->read_raw(3);
+		CHECK_EQ(raw->read_ubyte(), 0xAB);
+		CHECK_EQ(raw->read_ubyte(), 0xFF);
+		CHECK_EQ(raw->read_ubyte(), 0x0);
+
+		std::string message;
+		try {
+			(void) reader->read_string();
+		} catch (zenkit::ParserError const& e) {
+			message = e.what();
+		}
+		CHECK_NE(message.find("type mismatch: expected string, got: int"), std::string::npos);
+
+		CHECK_THROWS_AS((void) reader->read_int(), zenkit::ParserError);
+		CHECK(reader->read_object_end());
+	}
+
+	TEST_CASE("ReadArchive.read_object(references)") {
+		// Object indices which don't fit the object count in the header still need to resolve.
+		std::string_view data = "ZenGin Archive\nver 1\nzCArchiverGeneric\nASCII\nsaveGame 1\n"
+		                        "date 01.01.2001 00:00:00\nuser luis\nEND\nobjects 2\nEND\n\n"
+		                        "[% zCWaypoint 0 1]\n"
+		                        "\twpName=string:A\n\twaterDepth=int:0\n\tunderWater=bool:0\n"
+		                        "\tposition=vec3:0 0 0\n\tdirection=vec3:0 0 1\n"
+		                        "[]\n"
+		                        "[% zCWaypoint 0 4000000000]\n"
+		                        "\twpName=string:B\n\twaterDepth=int:0\n\tunderWater=bool:0\n"
+		                        "\tposition=vec3:0 0 0\n\tdirection=vec3:0 0 1\n"
+		                        "[]\n"
+		                        "[% \xA7 0 4000000000]\n[]\n"
+		                        "[% \xA7 0 1]\n[]\n"
+		                        "[% \xA7 0 2]\n[]\n";
+
+		auto in = zenkit::Read::from(reinterpret_cast<std::byte const*>(data.data()), data.size());
+		auto reader = zenkit::ReadArchive::from(in.get());
+
+		auto a = reader->read_object(zenkit::GameVersion::GOTHIC_2);
+		auto b = reader->read_object(zenkit::GameVersion::GOTHIC_2);
+		REQUIRE_NE(a, nullptr);
+		REQUIRE_NE(b, nullptr);
+
+		CHECK_EQ(reader->read_object(zenkit::GameVersion::GOTHIC_2), b);
+		CHECK_EQ(reader->read_object(zenkit::GameVersion::GOTHIC_2), a);
+		CHECK_EQ(reader->read_object(zenkit::GameVersion::GOTHIC_2), nullptr);
+	}
+
 	TEST_CASE("ReadArchive.open(BINARY)") {
 		auto in = zenkit::Read::from("./samples/binary.zen");
 		auto reader = zenkit::ReadArchive::from(in.get());
@@ -122,4 +297,491 @@ TEST_SUITE("ReadArchive") {
 	TEST_CASE("ReadArchive.open(BIN_SAFE)" * doctest::skip()) {
 		// FIXME: Stub
 	}
+
+	TEST_CASE("ReadArchive.read_event") {
+		for (auto format :
+		     {zenkit::ArchiveFormat::ASCII, zenkit::ArchiveFormat::BINARY, zenkit::ArchiveFormat::BINSAFE}) {
+			std::vector<std::byte> buf;
+			auto w = zenkit::Write::to(&buf);
+
+			{
+				auto ar = zenkit::WriteArchive::to(w.get(), format);
+				ar->write_object_begin("%", "oCWorld:zCWorld", 64513);
+				ar->write_object_begin("WayNet", "zCWayNet", 0);
+				ar->write_int("waynetVersion", 1);
+				ar->write_string("name", "skipped");
+				ar->write_object_begin("wp", "zCWaypoint", 0);
+				ar->write_float("radius", 2.0f);
+				ar->write_object_end();
+				ar->write_object_end();
+				ar->write_object_end();
+				ar->write_header();
+			}
+
+			auto in = zenkit::Read::from(&buf);
+			auto reader = zenkit::ReadArchive::from(in.get());
+
+			zenkit::ArchiveEvent ev;
+			REQUIRE(reader->read_event(ev));
+			CHECK_EQ(ev.type, zenkit::ArchiveEventType::OBJECT_BEGIN);
+			CHECK_EQ(ev.object.class_name, "oCWorld:zCWorld");
+
+			REQUIRE(reader->read_event(ev));
+			CHECK_EQ(ev.type, zenkit::ArchiveEventType::OBJECT_BEGIN);
+			CHECK_EQ(ev.object.object_name, "WayNet");
+
+			REQUIRE(reader->read_event(ev));
+			REQUIRE_EQ(ev.type, zenkit::ArchiveEventType::ENTRY);
+
+			if (format == zenkit::ArchiveFormat::BINARY) {
+				// Binary archives have no information about the entries of objects, so the whole rest of the
+				// object is reported as one entry.
+				CHECK_EQ(ev.entry, zenkit::ArchiveEntryType::RAW);
+				CHECK(ev.name.empty());
+				CHECK_GT(ev.size, 4);
+				CHECK_EQ(reader->read_int(), 1);
+
+				REQUIRE(reader->read_event(ev));
+				CHECK_EQ(ev.type, zenkit::ArchiveEventType::ENTRY);
+				CHECK_EQ(ev.entry, zenkit::ArchiveEntryType::RAW);
+			} else {
+				CHECK_EQ(ev.entry, zenkit::ArchiveEntryType::INTEGER);
+				CHECK_EQ(ev.name, "waynetVersion");
+				CHECK_EQ(reader->read_int(), 1);
+
+				// Entries and objects which are not read are skipped.
+				REQUIRE(reader->read_event(ev));
+				CHECK_EQ(ev.type, zenkit::ArchiveEventType::ENTRY);
+				CHECK_EQ(ev.entry, zenkit::ArchiveEntryType::STRING);
+				CHECK_EQ(ev.name, "name");
+
+				REQUIRE(reader->read_event(ev));
+				CHECK_EQ(ev.type, zenkit::ArchiveEventType::OBJECT_BEGIN);
+				CHECK_EQ(ev.object.class_name, "zCWaypoint");
+
+				REQUIRE(reader->read_event(ev));
+				CHECK_EQ(ev.type, zenkit::ArchiveEventType::ENTRY);
+				CHECK_EQ(ev.entry, zenkit::ArchiveEntryType::FLOAT);
+				CHECK_EQ(ev.name, "radius");
+				CHECK_EQ(reader->read_float(), 2.0f);
+
+				REQUIRE(reader->read_event(ev));
+				CHECK_EQ(ev.type, zenkit::ArchiveEventType::OBJECT_END);
+			}
+
+			REQUIRE(reader->read_event(ev));
+			CHECK_EQ(ev.type, zenkit::ArchiveEventType::OBJECT_END);
+			REQUIRE(reader->read_event(ev));
+			CHECK_EQ(ev.type, zenkit::ArchiveEventType::OBJECT_END);
+			CHECK_FALSE(reader->read_event(ev));
+			CHECK_EQ(ev.type, zenkit::ArchiveEventType::END);
+		}
+	}
+
+	TEST_CASE("ReadArchive.set_memory_resource") {
+		struct CountingResource : std::pmr::memory_resource {
+			size_t allocated = 0;
+			size_t* freed;
+
+			explicit CountingResource(size_t* f) : freed(f) {}
+
+			~CountingResource() override {
+				++*freed;
+			}
+
+			void* do_allocate(size_t bytes, size_t alignment) override {
+				allocated += bytes;
+				return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+				std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+			}
+
+			[[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+				return this == &other;
+			}
+		};
+
+		std::vector<std::byte> buf;
+		{
+			auto w = zenkit::Write::to(&buf);
+			auto ar = zenkit::WriteArchive::to(w.get(), zenkit::ArchiveFormat::BINSAFE);
+			ar->write_object_begin("%", "zCWaypoint", 0);
+			ar->write_string("wpName", "WP_0");
+			ar->write_int("waterDepth", 0);
+			ar->write_bool("underWater", false);
+			ar->write_vec3("position", {});
+			ar->write_vec3("direction", {});
+			ar->write_object_end();
+			ar->write_header();
+		}
+
+		size_t freed = 0;
+		auto arena = std::make_shared<CountingResource>(&freed);
+		auto* resource = arena.get();
+
+		std::shared_ptr<zenkit::Object> obj;
+		{
+			auto in = zenkit::Read::from(&buf);
+			auto reader = zenkit::ReadArchive::from(in.get());
+			reader->set_memory_resource(std::move(arena));
+			obj = reader->read_object(zenkit::GameVersion::GOTHIC_1);
+		}
+
+		// The resource outlives the archive for as long as objects allocated from it are alive.
+		REQUIRE_NE(obj, nullptr);
+		CHECK_EQ(obj->get_object_type(), zenkit::ObjectType::zCWaypoint);
+		CHECK_GE(resource->allocated, sizeof(zenkit::WayPoint));
+		CHECK_EQ(freed, 0);
+
+		obj.reset();
+		CHECK_EQ(freed, 1);
+	}
+
+	TEST_CASE("ReadArchive.transcode") {
+		std::vector<std::byte> original;
+		auto w = zenkit::Write::to(&original);
+
+		{
+			auto ar = zenkit::WriteArchive::to(w.get(), zenkit::ArchiveFormat::BINSAFE);
+			ar->write_object_begin("%", "oCWorld:zCWorld", 64513);
+			ar->write_object_begin("MeshAndBsp", "", 0);
+			auto* raw = ar->get_stream();
+			raw->write_uint(0x4090000);
+			raw->write_uint(5);
+			raw->write_string("[]\n\xA7\x01");
+			ar->write_object_end();
+			ar->write_object_begin("VobTree", "", 0);
+			ar->write_int("childs0", 2);
+			auto vob = ar->write_object_begin("%", "zCUnknownVob:zCVob", 52224);
+			ar->write_string("vobName", "UNKNOWN");
+			ar->write_vec3("trafoOSToWSPos", {1, 2, 3});
+			ar->write_raw("rawData",
+			              std::vector<std::byte> {std::byte {0xDE}, std::byte {0x0E}, std::byte {0x00}, std::byte {0xAD}});
+			float floats[] {0.5f, 1.5f, 2.5f};
+			ar->write_raw_float("rawFloats", floats, 3);
+			ar->write_object_end();
+			ar->write_ref("%", vob);
+			ar->write_object_end();
+			ar->write_object_end();
+			ar->write_header();
+		}
+
+		// Convert to ASCII and back again.
+		std::vector<std::byte> ascii;
+		std::vector<std::byte> binsafe;
+
+		{
+			auto in = zenkit::Read::from(&original);
+			auto out = zenkit::Write::to(&ascii);
+			zenkit::ReadArchive::from(in.get())->transcode(out.get(), zenkit::ArchiveFormat::ASCII);
+		}
+
+		{
+			auto in = zenkit::Read::from(&ascii);
+			auto out = zenkit::Write::to(&binsafe);
+			zenkit::ReadArchive::from(in.get())->transcode(out.get(), zenkit::ArchiveFormat::BINSAFE);
+		}
+
+		for (auto* buf : {&ascii, &binsafe}) {
+			auto in = zenkit::Read::from(buf);
+			auto reader = zenkit::ReadArchive::from(in.get());
+
+			zenkit::ArchiveObject obj;
+			REQUIRE(reader->read_object_begin(obj));
+			CHECK_EQ(obj.class_name, "oCWorld:zCWorld");
+
+			REQUIRE(reader->read_object_begin(obj));
+			CHECK_EQ(obj.object_name, "MeshAndBsp");
+			CHECK_EQ(in->read_uint(), 0x4090000);
+			CHECK_EQ(in->read_uint(), 5);
+			CHECK_EQ(in->read_string(5), "[]\n\xA7\x01");
+			CHECK(reader->read_object_end());
+
+			REQUIRE(reader->read_object_begin(obj));
+			CHECK_EQ(obj.object_name, "VobTree");
+			CHECK_EQ(reader->read_int(), 2);
+
+			REQUIRE(reader->read_object_begin(obj));
+			CHECK_EQ(obj.class_name, "zCUnknownVob:zCVob");
+			auto index = obj.index;
+
+			CHECK_EQ(reader->read_string(), "UNKNOWN");
+			CHECK_EQ(reader->read_vec3(), zenkit::Vec3 {1, 2, 3});
+
+			auto raw = reader->read_raw(4);
+			CHECK_EQ(raw->read_ubyte(), 0xDE);
+			CHECK_EQ(raw->read_ubyte(), 0x0E);
+			CHECK_EQ(raw->read_ubyte(), 0x00);
+			CHECK_EQ(raw->read_ubyte(), 0xAD);
+
+			auto floats = reader->read_raw_float();
+			REQUIRE_EQ(floats.size(), 3);
+			CHECK_EQ(floats[2], 2.5f);
+			CHECK(reader->read_object_end());
+
+			REQUIRE(reader->read_object_begin(obj));
+			CHECK_EQ(obj.class_name, "\xA7");
+			CHECK_EQ(obj.index, index);
+			CHECK(reader->read_object_end());
+
+			CHECK(reader->read_object_end());
+			CHECK(reader->read_object_end());
+		}
+
+		// Binary archives can be copied, but not converted. Objects within levels which also contain entries keep
+		// their indices, so references to them must still resolve after copying.
+		auto wp = std::make_shared<zenkit::WayPoint>();
+		wp->name = "WP_COPY";
+
+		std::vector<std::byte> binary;
+		{
+			auto out = zenkit::Write::to(&binary);
+			auto ar = zenkit::WriteArchive::to(out.get(), zenkit::ArchiveFormat::BINARY);
+			ar->write_object_begin("%", "zCUnknown", 0);
+			ar->write_object_begin("VobTree", "%", 0);
+			ar->write_int("childs0", 1);
+			ar->write_object("wp", wp, zenkit::GameVersion::GOTHIC_1);
+			ar->write_object_end();
+			ar->write_object_begin("WayNet", "zCWayNet", 0);
+			ar->write_object("ref", wp, zenkit::GameVersion::GOTHIC_1);
+			ar->write_object_end();
+			ar->write_int("value", 42);
+			ar->write_object_end();
+			ar->write_header();
+		}
+
+		std::vector<std::byte> copy;
+		{
+			auto in = zenkit::Read::from(&binary);
+			auto out = zenkit::Write::to(&copy);
+			auto reader = zenkit::ReadArchive::from(in.get());
+			reader->transcode(out.get(), zenkit::ArchiveFormat::BINARY);
+
+			in->seek(0, zenkit::Whence::BEG);
+			reader = zenkit::ReadArchive::from(in.get());
+			CHECK_THROWS_AS(reader->transcode(out.get(), zenkit::ArchiveFormat::ASCII), zenkit::ParserError);
+		}
+
+		auto text = std::string_view {reinterpret_cast<char const*>(copy.data()), copy.size()};
+		CHECK_NE(text.find("objects 3 "), std::string_view::npos);
+
+		auto in = zenkit::Read::from(&copy);
+		auto reader = zenkit::ReadArchive::from(in.get());
+
+		zenkit::ArchiveObject obj;
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(obj.class_name, "zCUnknown");
+
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(reader->read_int(), 1);
+		auto point = reader->read_object<zenkit::WayPoint>(zenkit::GameVersion::GOTHIC_1);
+		REQUIRE_NE(point, nullptr);
+		CHECK_EQ(point->name, "WP_COPY");
+		CHECK(reader->read_object_end());
+
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(obj.class_name, "zCWayNet");
+		CHECK_EQ(obj.index, 2);
+		CHECK_EQ(reader->read_object<zenkit::WayPoint>(zenkit::GameVersion::GOTHIC_1), point);
+		CHECK(reader->read_object_end());
+
+		CHECK_EQ(reader->read_int(), 42);
+		CHECK(reader->read_object_end());
+	}
+
+	TEST_CASE("ReadArchive.transcode(samples)") {
+		auto original = zenkit::Read::from("./samples/G1/VOb/zCMover.zen");
+
+		// Convert to ASCII and back again. ASCII archives written by ZenKit contain bytes and words, which must be
+		// readable as such.
+		std::vector<std::byte> ascii;
+		std::vector<std::byte> binsafe;
+
+		{
+			auto out = zenkit::Write::to(&ascii);
+			zenkit::ReadArchive::from(original.get())->transcode(out.get(), zenkit::ArchiveFormat::ASCII);
+		}
+
+		{
+			auto in = zenkit::Read::from(&ascii);
+			auto out = zenkit::Write::to(&binsafe);
+			zenkit::ReadArchive::from(in.get())->transcode(out.get(), zenkit::ArchiveFormat::BINSAFE);
+		}
+
+		original->seek(0, zenkit::Whence::BEG);
+		auto expected = read_entries(original.get());
+
+		auto in = zenkit::Read::from(&ascii);
+		REQUIRE_EQ(expected.size(), read_entries(in.get()).size());
+
+		in = zenkit::Read::from(&binsafe);
+		auto actual = read_entries(in.get());
+		REQUIRE_EQ(expected.size(), actual.size());
+
+		auto small_ints = 0;
+		for (auto i = 0u; i < expected.size(); ++i) {
+			CHECK_EQ(expected[i].type, actual[i].type);
+			CHECK_EQ(expected[i].entry, actual[i].entry);
+			CHECK_EQ(expected[i].name, actual[i].name);
+			CHECK_EQ(expected[i].value, actual[i].value);
+
+			// ASCII archives store floats with limited precision.
+			REQUIRE_EQ(expected[i].floats.size(), actual[i].floats.size());
+			for (auto j = 0u; j < expected[i].floats.size(); ++j) {
+				CHECK_LT(std::abs(expected[i].floats[j] - actual[i].floats[j]), 0.001f);
+			}
+
+			auto entry = expected[i].entry;
+			if (entry == zenkit::ArchiveEntryType::BYTE || entry == zenkit::ArchiveEntryType::WORD) ++small_ints;
+		}
+
+		CHECK_NE(small_ints, 0);
+	}
+
+	TEST_CASE("ReadArchive.index_objects") {
+		for (auto format : {zenkit::ArchiveFormat::BINARY, zenkit::ArchiveFormat::BINSAFE}) {
+			std::vector<std::byte> buf;
+			auto w = zenkit::Write::to(&buf);
+
+			{
+				auto ar = zenkit::WriteArchive::to(w.get(), format);
+				ar->write_object_begin("%", "oCWorld:zCWorld", 64513);
+				ar->write_object_begin("VobTree", "zCVob", 52224);
+				ar->write_int("childs", 1);
+				ar->write_object_begin("visual", "zCMaterial", 17408);
+				ar->write_object_end();
+				ar->write_object_end();
+				ar->write_object_begin("WayNet", "zCWayNet", 0);
+				ar->write_int("waynetVersion", 1);
+				ar->write_object_end();
+				ar->write_object_end();
+				ar->write_header();
+			}
+
+			auto in = zenkit::Read::from(&buf);
+			auto reader = zenkit::ReadArchive::from(in.get());
+
+			auto mark = in->tell();
+			auto index = reader->index_objects();
+			CHECK_EQ(in->tell(), mark);
+
+			// Binary archives can't look into objects which contain entries other than objects.
+			auto binary = format == zenkit::ArchiveFormat::BINARY;
+			REQUIRE_EQ(index.size(), binary ? 3 : 4);
+			CHECK_EQ(index[0].offset, mark);
+			CHECK_EQ(index[0].depth, 0);
+			CHECK_EQ(index[0].object.class_name, "oCWorld:zCWorld");
+			CHECK_EQ(index[1].depth, 1);
+			CHECK_EQ(index[1].object.object_name, "VobTree");
+			CHECK_EQ(index.back().depth, 1);
+			CHECK_EQ(index.back().object.object_name, "WayNet");
+
+			if (!binary) {
+				CHECK_EQ(index[2].depth, 2);
+				CHECK_EQ(index[2].object.class_name, "zCMaterial");
+				CHECK_EQ(reader->find_object(2), &index[2]);
+			} else {
+				CHECK_EQ(reader->find_object(2), nullptr);
+			}
+
+			auto const* waynet = reader->find_object(3);
+			REQUIRE_NE(waynet, nullptr);
+
+			zenkit::ArchiveObject obj;
+			reader->seek_object(*waynet);
+			REQUIRE(reader->read_object_begin(obj));
+			CHECK_EQ(obj.class_name, "zCWayNet");
+			CHECK_EQ(reader->read_int(), 1);
+			CHECK(reader->read_object_end());
+
+			// The end of the enclosing object can still be detected.
+			CHECK(reader->read_object_end());
+			CHECK_FALSE(reader->read_object_begin(obj));
+		}
+	}
+
+	TEST_CASE("ReadArchive.skip_object(BIN_SAFE)") {
+		std::vector<std::byte> buf;
+		auto w = zenkit::Write::to(&buf);
+
+		{
+			auto ar = zenkit::WriteArchive::to(w.get(), zenkit::ArchiveFormat::BINSAFE);
+			ar->write_object_begin("root", "zCVob", 52224);
+			ar->write_string("name", "hello");
+			ar->write_object_begin("child", "zCMaterial", 17408);
+			ar->write_int("value", 1);
+			ar->write_object_begin("grandchild", "%", 0);
+			ar->write_object_end();
+			ar->write_string("text", "[not an object]");
+			ar->write_object_end();
+			ar->write_int("after", 42);
+			ar->write_object_end();
+			ar->write_header();
+		}
+
+		auto in = zenkit::Read::from(&buf);
+		auto reader = zenkit::ReadArchive::from(in.get());
+
+		zenkit::ArchiveObject obj;
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(obj.object_name, "root");
+		CHECK_EQ(obj.class_name, "zCVob");
+		CHECK_EQ(obj.version, 52224);
+		CHECK_EQ(obj.index, 0);
+		CHECK_FALSE(reader->read_object_end());
+		CHECK_EQ(reader->read_string(), "hello");
+
+		auto mark = in->tell();
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(obj.object_name, "child");
+		CHECK_EQ(obj.class_name, "zCMaterial");
+		CHECK_EQ(obj.version, 17408);
+		CHECK_EQ(obj.index, 1);
+
+		// Skipping the object from its beginning or from within it must end up at the same position.
+		reader->skip_object(true);
+		auto end = in->tell();
+		CHECK_EQ(reader->read_int(), 42);
+
+		in->seek(static_cast<ssize_t>(mark), zenkit::Whence::BEG);
+		reader->skip_object(false);
+		CHECK_EQ(in->tell(), end);
+		CHECK_EQ(reader->read_int(), 42);
+		CHECK(reader->read_object_end());
+	}
+
+	TEST_CASE("ReadArchive.read_object_begin(BIN_SAFE,atoi)") {
+		std::vector<std::byte> buf;
+		auto w = zenkit::Write::to(&buf);
+
+		// Header fields are separated by spaces, so the class name can be used to inject odd numbers.
+		{
+			auto ar = zenkit::WriteArchive::to(w.get(), zenkit::ArchiveFormat::BINSAFE);
+			ar->write_object_begin("a", "b +12 \t+7", 0);
+			ar->write_object_begin("a", "b 1x 4000000000", 0);
+			ar->write_object_begin("a", "b +-1 99999999999999999999", 0);
+			ar->write_object_end();
+			ar->write_object_end();
+			ar->write_object_end();
+			ar->write_header();
+		}
+
+		auto in = zenkit::Read::from(&buf);
+		auto reader = zenkit::ReadArchive::from(in.get());
+
+		zenkit::ArchiveObject obj;
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(obj.version, 12);
+		CHECK_EQ(obj.index, 7);
+
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(obj.version, 1);
+		CHECK_EQ(obj.index, 4000000000u);
+
+		REQUIRE(reader->read_object_begin(obj));
+		CHECK_EQ(obj.version, 0);
+		CHECK_EQ(obj.index, 0xFFFFFFFFu);
+	}
 }
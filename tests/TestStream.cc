@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: MIT
 #include "zenkit/Stream.hh"
 
+#include <sstream>
+
 #include <doctest/doctest.h>
 
 template <typename... Args>
@@ -141,6 +143,117 @@ TEST_SUITE("Read") {
 		CHECK(r->eof());
 		CHECK(r->read_line(true).empty());
 	}
+
+	TEST_CASE("Read.read_line_then_ignore") {
+		static constexpr char RAW[] = "first line is long enough\r\n\t\t  indented=string:value with spaces\n"
+		                              "\n\nno-terminator-here-at-all\0after null\n  \0tail";
+		std::string data {RAW, sizeof RAW - 1};
+
+		// Memory-backed streams take a fast path which must behave exactly like the generic one.
+		auto mem = zenkit::Read::from(reinterpret_cast<std::byte const*>(data.data()), data.size());
+		std::istringstream stream {data};
+		auto gen = zenkit::Read::from(&stream);
+
+		for (auto i = 0; i < 3; ++i) {
+			auto line = gen->read_line(true);
+			CHECK_EQ(mem->read_line(true), line);
+			CHECK_EQ(mem->tell(), gen->tell());
+		}
+
+		CHECK_EQ(mem->read_line_then_ignore("\n "), "after null");
+		CHECK_EQ(gen->read_line_then_ignore("\n "), "after null");
+		CHECK_EQ(mem->tell(), gen->tell());
+		CHECK_EQ(mem->read_line(true), "");
+		CHECK_EQ(mem->read_line(true), "tail");
+		CHECK(mem->eof());
+	}
+
+	TEST_CASE("Read.read_string_view") {
+		auto data = bytes('H', 'i', 'H', 'e', 'l', 'l', 'o', '!');
+		auto r = zenkit::Read::from(&data);
+
+		auto view = r->read_string_view(2);
+		CHECK_EQ(view, "Hi");
+		CHECK_EQ(static_cast<void const*>(view.data()), static_cast<void const*>(data.data()));
+		CHECK_EQ(r->read_string_view(6), "Hello!");
+
+		CHECK(r->eof());
+		CHECK_EQ(r->read_string_view(1), std::string_view {"\0", 1});
+	}
+
+	TEST_CASE("Read.read_line_view") {
+		auto data = bytes('H', 'i', '\n', ' ', ' ', '\r', '\t', 'Y', 'o', '\r', '\n', 'A', '\0', 'B', '\n', ' ', '\0');
+
+		auto r = zenkit::Read::from(&data);
+		CHECK_EQ(r->read_line_view(true), "Hi");
+		CHECK_EQ(r->tell(), 7);
+		CHECK_EQ(r->read_line_view(false), "Yo");
+		CHECK_EQ(r->tell(), 10);
+		CHECK_EQ(r->read_line_view(true), "");
+		CHECK_EQ(r->read_line_view(true), "A");
+		CHECK_EQ(r->tell(), 13);
+		CHECK_EQ(r->read_line_view(true), "B");
+		CHECK(r->eof());
+		CHECK(r->read_line_view(true).empty());
+
+		// Make sure the semantics match those of streams without a cursor.
+		std::istringstream stream {std::string {reinterpret_cast<char const*>(data.data()), data.size()}};
+		r = zenkit::Read::from(&stream);
+		CHECK_EQ(r->read_line_view(true), "Hi");
+		CHECK_EQ(r->tell(), 7);
+		CHECK_EQ(r->read_line_view(false), "Yo");
+		CHECK_EQ(r->tell(), 10);
+		CHECK_EQ(r->read_line_view(true), "");
+		CHECK_EQ(r->read_line_view(true), "A");
+		CHECK_EQ(r->tell(), 13);
+		CHECK_EQ(r->read_line_view(true), "B");
+	}
+
+	TEST_CASE("Read.cursor") {
+		auto r = zenkit::Read::from(bytes(0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0xFF));
+		auto* cursor = r->cursor();
+		REQUIRE(cursor != nullptr);
+		CHECK_EQ(cursor->size(), 7);
+
+		CHECK_EQ(r->read_uint(), 1);
+		CHECK_EQ(cursor->tell(), 4);
+		CHECK_EQ(cursor->read<uint16_t>(), 2);
+		CHECK_EQ(r->tell(), 6);
+
+		r->seek(-1, zenkit::Whence::CUR);
+		CHECK_EQ(cursor->remaining(), 2);
+
+		cursor->seek(10, zenkit::Whence::BEG);
+		CHECK_EQ(r->tell(), 5);
+
+		CHECK_EQ(cursor->read<uint32_t>(), 0xFF00);
+		CHECK(r->eof());
+
+		std::istringstream stream {"test"};
+		CHECK_EQ(zenkit::Read::from(&stream)->cursor(), nullptr);
+	}
+
+	TEST_CASE("Read.read_array") {
+		auto r = zenkit::Read::from(bytes(0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0xFF));
+
+		std::vector<uint16_t> v(4, 0xAAAA);
+		r->read_array<uint16_t>(v);
+
+		CHECK_EQ(v[0], 1);
+		CHECK_EQ(v[1], 2);
+		CHECK_EQ(v[2], 3);
+		CHECK_EQ(v[3], 0x00FF);
+		CHECK(r->eof());
+
+		std::istringstream stream {std::string {"\x04\x00\x05", 3}};
+		r = zenkit::Read::from(&stream);
+		r->read_array<uint16_t>(v);
+
+		CHECK_EQ(v[0], 4);
+		CHECK_EQ(v[1], 5);
+		CHECK_EQ(v[2], 0);
+		CHECK_EQ(v[3], 0);
+	}
 }
 
 TEST_SUITE("Write") {
@@ -287,4 +400,41 @@ TEST_SUITE("Write") {
 		CHECK_EQ(BUF[5], std::byte {'!'});
 		CHECK_EQ(BUF[6], std::byte {'\n'});
 	}
+
+	TEST_CASE("Write.write_array") {
+		auto w = zenkit::Write::to(&BUF);
+		BUF.clear();
+
+		std::vector<uint16_t> v {0xFFFF, 1};
+		w->write_array<uint16_t>(v);
+
+		CHECK_EQ(BUF.size(), 4);
+		CHECK_EQ(BUF[0], std::byte {0xFF});
+		CHECK_EQ(BUF[1], std::byte {0xFF});
+		CHECK_EQ(BUF[2], std::byte {0x01});
+		CHECK_EQ(BUF[3], std::byte {0x00});
+	}
+
+	TEST_CASE("Write.buffered") {
+		std::vector<std::byte> out;
+		auto sink = zenkit::Write::to(&out);
+
+		{
+			auto w = zenkit::Write::buffered(sink.get(), 4);
+
+			auto off = w->reserve(sizeof(uint32_t));
+			w->write_ushort(0xAABB);
+			w->write_uint(0x11223344);
+			w->write_uint_at(off, 0xCAFEBABE);
+			CHECK_EQ(w->tell(), 10);
+
+			w->seek(4, zenkit::Whence::BEG);
+			w->write_ushort(0x0102);
+			w->seek(0, zenkit::Whence::END);
+			w->write_ubyte(0x7F);
+			CHECK_EQ(w->tell(), 11);
+		}
+
+		CHECK_EQ(out, bytes(0xBE, 0xBA, 0xFE, 0xCA, 0x02, 0x01, 0x44, 0x33, 0x22, 0x11, 0x7F));
+	}
 }
@@ -4,6 +4,18 @@
 
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stack>
+#include <string>
+#include <thread>
+#include <tuple>
+
 void check_vfs(zenkit::Vfs const& vdf) {
 	// Checks if all entries are here
 
@@ -57,6 +69,22 @@ void check_vfs(zenkit::Vfs const& vdf) {
 	CHECK_NE(vdf.resolve("licEnSES /GPL/gpl-3.0.md "), nullptr);
 }
 
+/// \brief Write the paths, times and first bytes of all nodes below \p node to \p out.
+template <typename Node>
+void dump_vfs(Node const& node, std::string const& path, std::string& out) {
+	for (auto& child : node.children()) {
+		auto child_path = path + "/" + std::string {child.name()};
+		out += child_path + "@" + std::to_string(child.time());
+
+		if (child.type() == zenkit::VfsNodeType::FILE) {
+			out += "=" + std::string(1, static_cast<char>(child.open_read()->read_ubyte())) + "\n";
+		} else {
+			out += "\n";
+			dump_vfs(child, child_path, out);
+		}
+	}
+}
+
 TEST_SUITE("Vfs") {
 	TEST_CASE("Vfs.mount_disk(GOTHIC?)") {
 		auto vdf = zenkit::Vfs {};
@@ -64,9 +92,635 @@ TEST_SUITE("Vfs") {
 		check_vfs(vdf);
 	}
 
+	TEST_CASE("Vfs.mount_disk(GOTHIC?,hints)") {
+		auto vdf = zenkit::Vfs {};
+		vdf.mount_disk("./samples/basic.vdf",
+		               zenkit::VfsOverwriteBehavior::OLDER,
+		               zenkit::MmapHint::RANDOM | zenkit::MmapHint::POPULATE | zenkit::MmapHint::HUGE_PAGES);
+		check_vfs(vdf);
+	}
+
+	TEST_CASE("Vfs.mount_disks") {
+		static constexpr std::byte DATA[] {std::byte {'A'}, std::byte {'B'}, std::byte {'C'}};
+		auto tmp = std::filesystem::temp_directory_path();
+
+		// Build three disks with conflicting files and directories at different timestamps.
+		std::vector<std::filesystem::path> disks;
+		auto make_disk = [&](std::string const& name, time_t ts, std::vector<std::string> const& dirs, size_t data) {
+			zenkit::Vfs vfs;
+			for (auto& dir : dirs) {
+				auto& node = vfs.mkdir(dir);
+				node.create(zenkit::VfsNode::file("FILE.TXT", zenkit::VfsFileDescriptor {DATA + data, 1, false}));
+			}
+
+			auto path = tmp / name;
+			auto w = zenkit::Write::to(path);
+			vfs.save(w.get(), zenkit::GameVersion::GOTHIC_2, ts);
+			disks.push_back(path);
+		};
+
+		make_disk("zk_mount_disks_0.vdf", 978307200, {"A", "A/B", "C"}, 0);
+		make_disk("zk_mount_disks_1.vdf", 978307200 + 86400 * 2, {"A/B", "C/FILE.TXT", "D"}, 1);
+		make_disk("zk_mount_disks_2.vdf", 978307200 + 86400, {"A", "C", "D/E"}, 2);
+
+		for (auto overwrite : {zenkit::VfsOverwriteBehavior::NONE,
+		                       zenkit::VfsOverwriteBehavior::ALL,
+		                       zenkit::VfsOverwriteBehavior::NEWER,
+		                       zenkit::VfsOverwriteBehavior::OLDER}) {
+			zenkit::Vfs sequential;
+			for (auto& disk : disks) {
+				sequential.mount_disk(disk, overwrite);
+			}
+
+			zenkit::Vfs batch;
+			batch.mount_disks(disks, overwrite);
+
+			std::string expected, actual;
+			dump_vfs(sequential.root(), "", expected);
+			dump_vfs(batch.root(), "", actual);
+
+			CHECK_FALSE(expected.empty());
+			CHECK_EQ(actual, expected);
+		}
+
+		// Mounting with a cache yields the same file system whether the cache is fresh, stale or broken.
+		{
+			auto cache = tmp / "zk_mount_disks.idx";
+			auto old_time = std::filesystem::file_time_type::clock::now() - std::chrono::hours(24);
+			std::filesystem::remove(cache);
+
+			zenkit::Vfs sequential;
+			for (auto& disk : disks) {
+				sequential.mount_disk(disk, zenkit::VfsOverwriteBehavior::OLDER);
+			}
+
+			std::string expected;
+			dump_vfs(sequential.root(), "", expected);
+
+			auto mount_cached = [&]() {
+				zenkit::Vfs cached;
+				cached.mount_disks(disks, cache);
+
+				std::string actual;
+				dump_vfs(cached.root(), "", actual);
+				CHECK_EQ(actual, expected);
+				CHECK_NE(cached.find("FILE.TXT"), nullptr);
+				CHECK_NE(cached.resolve("A/B/FILE.TXT"), nullptr);
+			};
+
+			// The cache is created on first use ...
+			mount_cached();
+			REQUIRE(std::filesystem::exists(cache));
+
+			// ... and used as-is afterward.
+			std::filesystem::last_write_time(cache, old_time);
+			mount_cached();
+			CHECK_EQ(std::filesystem::last_write_time(cache), old_time);
+
+			// A changed disk invalidates the cache.
+			std::filesystem::last_write_time(disks[1], old_time);
+			mount_cached();
+			CHECK_NE(std::filesystem::last_write_time(cache), old_time);
+
+			// A broken cache is replaced.
+			std::filesystem::resize_file(cache, std::filesystem::file_size(cache) - 3);
+			std::filesystem::last_write_time(cache, old_time);
+			mount_cached();
+			CHECK_NE(std::filesystem::last_write_time(cache), old_time);
+
+			std::filesystem::remove(cache);
+		}
+
+		// Disks before a broken one stay mounted.
+		std::vector<std::filesystem::path> broken {disks[0], "./samples/basic.bin"};
+		zenkit::Vfs vfs;
+		CHECK_THROWS(vfs.mount_disks(broken));
+		CHECK_NE(vfs.resolve("A/B/FILE.TXT"), nullptr);
+
+		for (auto& disk : disks) {
+			std::filesystem::remove(disk);
+		}
+	}
+
+	TEST_CASE("VfsCompact.from_disks") {
+		static constexpr std::byte DATA[] {std::byte {'A'}, std::byte {'B'}, std::byte {'C'}, std::byte {'D'}};
+		auto tmp = std::filesystem::temp_directory_path();
+
+		std::vector<std::filesystem::path> basic {"./samples/basic.vdf"};
+		auto vdf = zenkit::VfsCompact::from_disks(basic);
+		CHECK_EQ(vdf.root().children().size(), 3);
+		CHECK_EQ(vdf.resolve(""), &vdf.root());
+		CHECK_EQ(vdf.resolve("/"), &vdf.root());
+
+		auto const* licenses = vdf.resolve("/LICENSES");
+		REQUIRE_NE(licenses, nullptr);
+		CHECK(licenses->type() == zenkit::VfsNodeType::DIRECTORY);
+		CHECK_EQ(licenses->children().size(), 2);
+		CHECK_EQ(licenses->child("gpl"), vdf.resolve("licEnSES /GPL "));
+		CHECK_EQ(vdf.resolve("licEnSES/GPL/nonexistent"), nullptr);
+		CHECK_EQ(vdf.resolve("licEnSES/GPL/gpl-3.0.md/file"), nullptr);
+
+		auto const* mit = vdf.resolve("licenses/MIT.MD");
+		REQUIRE_NE(mit, nullptr);
+		CHECK(mit->type() == zenkit::VfsNodeType::FILE);
+		CHECK(mit->children().empty());
+		CHECK_EQ(mit->child("x"), nullptr);
+		CHECK_THROWS(std::ignore = licenses->open_read());
+
+		// The contents are the same as those of a Vfs.
+		zenkit::Vfs reference;
+		reference.mount_disk(basic[0]);
+
+		std::string expected, actual;
+		dump_vfs(reference.root(), "", expected);
+		dump_vfs(vdf.root(), "", actual);
+		CHECK_EQ(actual, expected);
+
+		auto a = mit->open_read();
+		auto b = reference.resolve("licenses/MIT.MD")->open_read();
+		a->seek(0, zenkit::Whence::END);
+		b->seek(0, zenkit::Whence::END);
+		CHECK_EQ(a->tell(), b->tell());
+
+		// Loading multiple disks yields the same file system as mounting them into a Vfs one by one.
+		std::vector<std::filesystem::path> disks;
+		auto make_disk = [&](std::string const& name, time_t ts, std::vector<std::string> const& dirs, size_t data) {
+			zenkit::Vfs vfs;
+			for (auto& dir : dirs) {
+				auto& node = vfs.mkdir(dir);
+				node.create(zenkit::VfsNode::file("FILE.TXT", zenkit::VfsFileDescriptor {DATA + data, 1, false}));
+			}
+
+			auto path = tmp / name;
+			auto w = zenkit::Write::to(path);
+			vfs.save(w.get(), zenkit::GameVersion::GOTHIC_2, ts);
+			disks.push_back(path);
+		};
+
+		make_disk("zk_compact_0.vdf", 978307200, {"A", "A/B", "C"}, 0);
+		make_disk("zk_compact_1.vdf", 978307200 + 86400 * 2, {"A/B", "C/FILE.TXT", "D"}, 1);
+		make_disk("zk_compact_2.vdf", 978307200 + 86400, {"A", "C", "D/E"}, 2);
+		make_disk("zk_compact_3.vdf", 978307200 + 86400 * 3, {"a/b/file.txt", "c", "d/e/FILE.TXT/F"}, 3);
+
+		for (auto overwrite : {zenkit::VfsOverwriteBehavior::NONE,
+		                       zenkit::VfsOverwriteBehavior::ALL,
+		                       zenkit::VfsOverwriteBehavior::NEWER,
+		                       zenkit::VfsOverwriteBehavior::OLDER}) {
+			zenkit::Vfs sequential;
+			for (auto& disk : disks) {
+				sequential.mount_disk(disk, overwrite);
+			}
+
+			expected.clear();
+			actual.clear();
+			dump_vfs(sequential.root(), "", expected);
+			dump_vfs(zenkit::VfsCompact::from_disks(disks, overwrite).root(), "", actual);
+
+			CHECK_FALSE(expected.empty());
+			CHECK_EQ(actual, expected);
+		}
+
+		std::vector<std::filesystem::path> broken {disks[0], "./samples/basic.bin"};
+		CHECK_THROWS_AS(std::ignore = zenkit::VfsCompact::from_disks(broken), zenkit::VfsBrokenDiskError);
+
+		for (auto& disk : disks) {
+			std::filesystem::remove(disk);
+		}
+	}
+
 	TEST_CASE("Vfs.mount_host(GOTHIC?)") {
 		auto vdf = zenkit::Vfs {};
 		vdf.mount_host("./samples/basic.vdf.dir", "/");
 		check_vfs(vdf);
 	}
+
+	TEST_CASE("Vfs.save") {
+		auto src = zenkit::Vfs {};
+		src.mount_host("./samples/basic.vdf.dir", "/");
+
+		auto read_all = [](zenkit::VfsNode const* node) {
+			auto r = node->open_read();
+			r->seek(0, zenkit::Whence::END);
+			auto size = r->tell();
+			r->seek(0, zenkit::Whence::BEG);
+			return r->read_string(size);
+		};
+
+		for (std::uint32_t alignment : {1u, 4096u}) {
+			std::vector<std::byte> buffer;
+			auto w = zenkit::Write::to(&buffer);
+			src.save(w.get(), zenkit::GameVersion::GOTHIC_1, 978307200, alignment);
+
+			auto vdf = zenkit::Vfs {};
+			auto r = zenkit::Read::from(&buffer);
+			vdf.mount_disk(r.get());
+			check_vfs(vdf);
+
+			CHECK_EQ(read_all(vdf.find("readme.md")), read_all(src.find("readme.md")));
+			CHECK_EQ(read_all(vdf.find("gpl-3.0.md")), read_all(src.find("gpl-3.0.md")));
+
+			// Check the offsets of all files in the catalog.
+			r->seek(256 + 16, zenkit::Whence::BEG);
+			auto count = r->read_uint();
+			r->seek(296, zenkit::Whence::BEG);
+
+			for (std::uint32_t i = 0; i < count; ++i) {
+				r->seek(64, zenkit::Whence::CUR);
+				auto offset = r->read_uint();
+				auto size = r->read_uint();
+				auto type = r->read_uint();
+				r->seek(4, zenkit::Whence::CUR);
+
+				if ((type & 0x80000000) != 0) continue;
+				CHECK_EQ(offset % alignment, 0);
+				CHECK_LE(offset + size, buffer.size());
+			}
+		}
+	}
+
+	TEST_CASE("Vfs.content_id") {
+		static constexpr std::byte ABC[] {std::byte {'a'}, std::byte {'b'}, std::byte {'c'}};
+
+		std::vector<std::byte> large(1000);
+		for (size_t i = 0; i < large.size(); ++i) {
+			large[i] = static_cast<std::byte>(i * 7);
+		}
+
+		auto copy = large;
+		auto* owned = new std::byte[large.size()];
+		std::copy(large.begin(), large.end(), owned);
+
+		auto vfs = zenkit::Vfs {};
+		auto& a = vfs.mkdir("A");
+		auto& b = vfs.mkdir("B");
+		a.create(zenkit::VfsNode::file("ABC", zenkit::VfsFileDescriptor {ABC, 3, false}));
+		a.create(zenkit::VfsNode::file("EMPTY", zenkit::VfsFileDescriptor {ABC, 0, false}));
+		a.create(zenkit::VfsNode::file("LARGE", zenkit::VfsFileDescriptor {large.data(), large.size(), false}));
+		b.create(zenkit::VfsNode::file("COPY", zenkit::VfsFileDescriptor {copy.data(), copy.size(), false}));
+		b.create(zenkit::VfsNode::file("OWNED", zenkit::VfsFileDescriptor {owned, large.size(), true}));
+		b.create(zenkit::VfsNode::file("SHORT", zenkit::VfsFileDescriptor {copy.data(), copy.size() - 1, false}));
+		vfs.index_contents();
+
+		// Content identifiers are XXH64 hashes.
+		CHECK_EQ(vfs.content_id(*vfs.resolve("A/ABC")), 0x44BC2CF5AD770999);
+		CHECK_EQ(vfs.content_id(*vfs.resolve("A/EMPTY")), 0xEF46DB3751D8E999);
+
+		auto id = vfs.content_id(*vfs.resolve("A/LARGE"));
+		CHECK_EQ(vfs.content_id(*vfs.resolve("B/COPY")), id);
+		CHECK_EQ(vfs.content_id(*vfs.resolve("B/OWNED")), id);
+		CHECK_NE(vfs.content_id(*vfs.resolve("B/SHORT")), id);
+		CHECK_THROWS(vfs.content_id(*vfs.resolve("A")));
+
+		// Files with identical contents are stored only once.
+		std::vector<std::byte> plain;
+		std::vector<std::byte> dedup;
+		vfs.save(zenkit::Write::to(&plain).get(), zenkit::GameVersion::GOTHIC_2, 978307200);
+		vfs.save(zenkit::Write::to(&dedup).get(), zenkit::GameVersion::GOTHIC_2, 978307200, 1, true);
+		CHECK_EQ(plain.size() - dedup.size(), 2 * large.size());
+
+		auto loaded = zenkit::Vfs {};
+		auto r = zenkit::Read::from(&dedup);
+		loaded.mount_disk(r.get());
+
+		for (auto path : {"A/ABC", "A/EMPTY", "A/LARGE", "B/COPY", "B/OWNED", "B/SHORT"}) {
+			CHECK_EQ(loaded.content_id(*loaded.resolve(path)), vfs.content_id(*vfs.resolve(path)));
+		}
+
+		// Replacing a file with other contents at the same address must not return the old identifier.
+		auto snapshot = vfs.snapshot();
+		CHECK_EQ(snapshot->content_id(*snapshot->resolve("A/LARGE")), id);
+
+		vfs.remove("A/LARGE");
+		large[0] = std::byte {0xFF};
+		a.create(zenkit::VfsNode::file("LARGE", zenkit::VfsFileDescriptor {large.data(), large.size(), false}));
+		CHECK_NE(vfs.content_id(*vfs.resolve("A/LARGE")), id);
+		CHECK_EQ(vfs.content_id(*vfs.resolve("B/COPY")), id);
+	}
+
+	TEST_CASE("Vfs.mount_host(limit)") {
+		auto vdf = zenkit::Vfs {};
+		vdf.set_host_file_limit(1);
+		vdf.mount_host("./samples/basic.vdf.dir", "/");
+
+		auto read_all = [](zenkit::Read* r) {
+			r->seek(0, zenkit::Whence::END);
+			auto size = r->tell();
+			r->seek(0, zenkit::Whence::BEG);
+			return r->read_string(size);
+		};
+
+		auto read_host = [](std::filesystem::path const& path) {
+			std::ifstream stream {path, std::ios::in | std::ios::binary};
+			return std::string {std::istreambuf_iterator<char> {stream}, std::istreambuf_iterator<char> {}};
+		};
+
+		auto const* readme = vdf.find("readme.md");
+		auto const* mit = vdf.find("mit.md");
+		REQUIRE_NE(readme, nullptr);
+		REQUIRE_NE(mit, nullptr);
+
+		// Readers stay valid even if their file has been evicted from the cache since.
+		auto r0 = readme->open_read();
+		auto r1 = mit->open_read();
+		auto r2 = readme->open_read();
+
+		CHECK_EQ(read_all(r0.get()), read_host("./samples/basic.vdf.dir/README.md"));
+		CHECK_EQ(read_all(r1.get()), read_host("./samples/basic.vdf.dir/licenses/MIT.md"));
+		CHECK_EQ(read_all(r2.get()), read_host("./samples/basic.vdf.dir/README.md"));
+
+		vdf.set_host_file_limit(0);
+		CHECK_EQ(read_all(vdf.find("config.yml")->open_read().get()),
+		         read_host("./samples/basic.vdf.dir/config.yml"));
+	}
+
+	TEST_CASE("Vfs.mount_host(changed)") {
+		auto dir = std::filesystem::temp_directory_path() / "zenkit-test-vfs-host";
+		std::filesystem::create_directories(dir);
+		std::ofstream {dir / "file.txt", std::ios::binary} << "0123456789abcdef";
+
+		auto vdf = zenkit::Vfs {};
+		vdf.mount_host(dir, "/");
+
+		auto const* file = vdf.find("file.txt");
+		REQUIRE_NE(file, nullptr);
+
+		// A file which changed its size after being mounted must not be read past its end.
+		std::ofstream {dir / "file.txt", std::ios::binary | std::ios::trunc} << "0123";
+		CHECK_THROWS_AS((void) file->open_read(), zenkit::Error);
+		CHECK_THROWS_AS((void) vdf.content_id(*file), zenkit::Error);
+
+		std::vector<std::byte> out;
+		auto w = zenkit::Write::to(&out);
+		CHECK_THROWS_AS(vdf.save(w.get(), zenkit::GameVersion::GOTHIC_1), zenkit::Error);
+
+		std::filesystem::remove_all(dir);
+	}
+
+	TEST_CASE("Vfs.snapshot") {
+		auto vdf = std::make_unique<zenkit::Vfs>();
+		vdf->mount_disk("./samples/basic.vdf");
+
+		// Owned file contents are shared between the Vfs and its snapshots.
+		auto* data = new std::byte[4] {std::byte {'d'}, std::byte {'a'}, std::byte {'t'}, std::byte {'a'}};
+		vdf->mkdir("owned").create(zenkit::VfsNode::file("data.bin", zenkit::VfsFileDescriptor {data, 4, true}));
+
+		auto snapshot = vdf->snapshot();
+		CHECK_EQ(snapshot->root().children().size(), 4);
+
+		std::atomic<bool> failed {false};
+		std::vector<std::thread> readers;
+		for (int i = 0; i < 4; ++i) {
+			readers.emplace_back([&snapshot, &failed] {
+				for (int j = 0; j < 200; ++j) {
+					auto const* mit = snapshot->find("mit.md");
+					auto const* owned = snapshot->resolve("OWNED/DATA.BIN");
+					if (mit == nullptr || owned == nullptr || snapshot->resolve("/modified") != nullptr) {
+						failed = true;
+						return;
+					}
+
+					auto r0 = mit->open_read();
+					auto r1 = owned->open_read();
+					if (r0->read_line(false).empty() || r1->read_string(4) != "data") failed = true;
+				}
+			});
+		}
+
+		// Modifying the Vfs must not affect the snapshot.
+		vdf->mkdir("modified");
+		vdf->remove("licenses");
+		vdf->remove("owned");
+		vdf.reset();
+
+		for (auto& reader : readers) {
+			reader.join();
+		}
+
+		CHECK_FALSE(failed);
+		CHECK_EQ(snapshot->root().children().size(), 4);
+		CHECK_NE(snapshot->resolve("licenses/gpl/lgpl-3.0.md"), nullptr);
+		CHECK_EQ(snapshot->find("gpl-3.0.md"), snapshot->resolve("LICENSES/GPL/GPL-3.0.MD"));
+		CHECK_EQ(snapshot->resolve("owned/data.bin")->open_read()->read_string(4), "data");
+	}
+
+	TEST_CASE("VfsOverlay") {
+		static constexpr std::byte DATA[] {std::byte {'m'}, std::byte {'o'}, std::byte {'d'}};
+
+		auto overlay = zenkit::VfsOverlay {};
+		auto base = overlay.push_disk("./samples/basic.vdf");
+
+		auto const* base_mit = overlay.resolve("licenses/mit.md");
+		REQUIRE_NE(base_mit, nullptr);
+		CHECK_EQ(overlay.find("MIT.MD"), base_mit);
+		CHECK_EQ(overlay.list("/").size(), 3);
+
+		// A mod replacing a file and adding a directory.
+		auto mod = std::make_shared<zenkit::Vfs>();
+		mod->mkdir("LICENSES").create(zenkit::VfsNode::file("MIT.MD", zenkit::VfsFileDescriptor {DATA, 3, false}));
+		mod->mkdir("licenses/extra");
+		auto mod_id = overlay.push(mod, 1);
+
+		CHECK_EQ(overlay.resolve("licenses/mit.md"), mod->resolve("licenses/mit.md"));
+		CHECK_EQ(overlay.find("mit.md"), mod->resolve("licenses/mit.md"));
+		CHECK_EQ(overlay.resolve("licenses/mit.md")->open_read()->read_string(3), "mod");
+		CHECK_NE(overlay.resolve("licenses/gpl/gpl-3.0.md"), nullptr);
+
+		auto listing = overlay.list("licenses");
+		REQUIRE_EQ(listing.size(), 3);
+		CHECK_EQ(listing[0]->name(), "extra");
+		CHECK_EQ(listing[1]->name(), "GPL");
+		CHECK_EQ(listing[2], mod->resolve("licenses/mit.md"));
+
+		// A file hides all nodes below it in layers with lower precedence.
+		auto hide = std::make_shared<zenkit::Vfs>();
+		hide->mkdir("/").create(zenkit::VfsNode::file("licenses", zenkit::VfsFileDescriptor {DATA, 3, false}));
+		auto hide_id = overlay.push(hide, 2);
+
+		CHECK(overlay.resolve("licenses")->type() == zenkit::VfsNodeType::FILE);
+		CHECK_EQ(overlay.resolve("licenses/mit.md"), nullptr);
+		CHECK_EQ(overlay.find("gpl-3.0.md"), nullptr);
+		CHECK(overlay.list("licenses").empty());
+		CHECK_EQ(overlay.list("").size(), 3);
+
+		// Popping layers restores the previous state.
+		CHECK(overlay.pop(hide_id));
+		CHECK_FALSE(overlay.pop(hide_id));
+		CHECK_EQ(overlay.resolve("licenses/mit.md"), mod->resolve("licenses/mit.md"));
+
+		CHECK(overlay.pop(mod_id));
+		CHECK_EQ(overlay.resolve("licenses/mit.md"), base_mit);
+		CHECK_EQ(overlay.resolve("licenses/extra"), nullptr);
+
+		// Layers with the same priority are ordered by the time they were pushed.
+		mod_id = overlay.push(mod);
+		CHECK_EQ(overlay.resolve("licenses/mit.md"), mod->resolve("licenses/mit.md"));
+		overlay.pop(base);
+		base = overlay.push_disk("./samples/basic.vdf");
+		CHECK_NE(overlay.resolve("LICENSES/MIT.md")->open_read()->read_string(3), "mod");
+		CHECK_NE(overlay.resolve("licenses/extra"), nullptr);
+	}
+
+	TEST_CASE("Vfs.glob") {
+		auto vdf = zenkit::Vfs {};
+		vdf.mount_disk("./samples/basic.vdf");
+
+		auto sorted = [](auto const& nodes) {
+			std::vector<std::string> names;
+			for (auto* node : nodes) {
+				names.push_back(node->name());
+			}
+
+			std::sort(names.begin(), names.end());
+			return names;
+		};
+
+		using names = std::vector<std::string>;
+		CHECK_EQ(sorted(vdf.with_extension(".md")), names {"GPL-3.0.MD", "LGPL-3.0.MD", "MIT.MD", "README.MD"});
+		CHECK_EQ(sorted(vdf.with_extension("*.YML")), names {"CONFIG.YML"});
+		CHECK(vdf.with_extension("tex").empty());
+
+		CHECK_EQ(sorted(vdf.glob("**/*.md")), sorted(vdf.with_extension("md")));
+		CHECK_EQ(sorted(vdf.glob("**/*.M?")), sorted(vdf.with_extension("md")));
+		CHECK_EQ(sorted(vdf.glob("licenses/**/*.md")), names {"GPL-3.0.MD", "LGPL-3.0.MD", "MIT.MD"});
+		CHECK_EQ(sorted(vdf.glob("licenses/*")), names {"GPL", "MIT.MD"});
+		CHECK_EQ(sorted(vdf.glob("/**/gpl//*")), names {"GPL-3.0.MD", "LGPL-3.0.MD"});
+		CHECK_EQ(sorted(vdf.glob("**/L?CENSES/**/**/*-3.0.md")), names {"GPL-3.0.MD", "LGPL-3.0.MD"});
+		CHECK_EQ(sorted(vdf.glob("*.yml")), names {"CONFIG.YML"});
+		CHECK_EQ(vdf.glob("**").size(), 7);
+		CHECK_EQ(vdf.glob("licenses/gpl/gpl-3.0.md").size(), 1);
+		CHECK(vdf.glob("readme.md/*").empty());
+		CHECK(vdf.glob("nonexistent/**").empty());
+		CHECK(vdf.glob("").empty());
+
+		// The extension index is kept up to date.
+		vdf.remove("licenses/gpl");
+		vdf.mkdir("new").create(zenkit::VfsNode::file("FILE.md", zenkit::VfsFileDescriptor {nullptr, 0, false}));
+		CHECK_EQ(sorted(vdf.with_extension("MD")), names {"FILE.md", "MIT.MD", "README.MD"});
+		CHECK_EQ(sorted(vdf.glob("**/*.md")), names {"FILE.md", "MIT.MD", "README.MD"});
+		CHECK_EQ(sorted(vdf.glob("new/**/*.md")), names {"FILE.md"});
+
+		// The extension index and the generic matcher produce the same nodes in the same order.
+		auto& docs = vdf.mkdir("new/DOCS.md");
+		docs.create(zenkit::VfsNode::file("A.md", zenkit::VfsFileDescriptor {nullptr, 0, false}));
+		vdf.mkdir("new/nested.md/deeper.MD");
+
+		auto fast = vdf.glob("**/*.md");
+		CHECK_EQ(fast, vdf.glob("**/*.m?"));
+		CHECK_EQ(fast, vdf.glob("**/**/*.md"));
+		CHECK_EQ(vdf.glob("new/**/*.md"), vdf.glob("new/**/*.m?"));
+
+		names order;
+		std::transform(fast.begin(), fast.end(), std::back_inserter(order), [](auto* n) { return n->name(); });
+		CHECK_EQ(order, names {"MIT.MD", "DOCS.md", "A.md", "FILE.md", "nested.md", "deeper.MD", "README.MD"});
+
+		vdf.remove("new/nested.md");
+		CHECK_EQ(vdf.glob("**/*.md").size(), 5);
+	}
+
+	TEST_CASE("Vfs.resolve(mutation)") {
+		static constexpr std::byte DATA[] {std::byte {0x01}};
+
+		auto vdf = zenkit::Vfs {};
+		vdf.mount_disk("./samples/basic.vdf");
+
+		auto& dir = vdf.mkdir("/new//Sub");
+		CHECK_EQ(vdf.resolve("NEW/sub"), &dir);
+		CHECK_EQ(vdf.resolve("//new //SUB//"), &dir);
+		CHECK_EQ(vdf.resolve("NEW/sub/file"), nullptr);
+
+		auto* file = dir.create(zenkit::VfsNode::file("File", zenkit::VfsFileDescriptor {DATA, 1, false}));
+		CHECK_EQ(vdf.resolve("new/sub/FILE "), file);
+
+		// Replacing a node must update the index.
+		auto* replaced = dir.create(zenkit::VfsNode::directory("FILE"));
+		CHECK_EQ(vdf.resolve("new/sub/file"), replaced);
+		CHECK(replaced->type() == zenkit::VfsNodeType::DIRECTORY);
+
+		// Mounting merges directories and indexes all new nodes.
+		auto mnt = zenkit::VfsNode::directory("licenses");
+		mnt.create(zenkit::VfsNode::file("extra.md", zenkit::VfsFileDescriptor {DATA, 1, false}));
+		vdf.mount(mnt, "/");
+		CHECK_NE(vdf.resolve("licenses/EXTRA.md"), nullptr);
+		CHECK_NE(vdf.resolve("licenses/gpl/gpl-3.0.md"), nullptr);
+
+		// Removing a directory removes all of its descendants.
+		CHECK(vdf.remove("licenses"));
+		CHECK_EQ(vdf.resolve("licenses"), nullptr);
+		CHECK_EQ(vdf.resolve("licenses/gpl/gpl-3.0.md"), nullptr);
+		CHECK_EQ(vdf.resolve("licenses/extra.md"), nullptr);
+		CHECK_NE(vdf.resolve("readme.md"), nullptr);
+
+		// Detached copies are not part of the index.
+		auto copy = *vdf.resolve("new");
+		copy.create(zenkit::VfsNode::directory("detached"));
+		CHECK_EQ(vdf.resolve("new/detached"), nullptr);
+
+		auto moved = std::move(vdf);
+		CHECK_EQ(moved.resolve("new/sub"), &dir);
+
+		auto assigned = zenkit::Vfs {};
+		assigned.mount_disk("./samples/basic.vdf");
+		assigned = std::move(moved);
+		CHECK_EQ(assigned.resolve("new/sub"), &dir);
+		CHECK_EQ(assigned.resolve("licenses"), nullptr);
+		CHECK_NE(assigned.find("readme.md"), nullptr);
+
+		// Nodes moved out of a Vfs remain usable after the Vfs is gone.
+		std::optional<zenkit::VfsNode> orphan;
+		{
+			auto tmp = zenkit::Vfs {};
+			tmp.mkdir("a/b/c");
+			orphan.emplace(std::move(*tmp.resolve("a")));
+		}
+
+		orphan->create(zenkit::VfsNode::directory("d"));
+		CHECK_NE(orphan->child("b"), nullptr);
+		CHECK_NE(orphan->child("d"), nullptr);
+	}
+
+	TEST_CASE("Vfs.find(duplicates)") {
+		static constexpr std::byte DATA[] {std::byte {0x01}};
+
+		// The depth-first search Vfs::find used to perform before it was backed by an index.
+		auto reference_find = [](zenkit::Vfs const& vfs, std::string_view name) -> zenkit::VfsNode const* {
+			std::stack<zenkit::VfsNode const*> tree {{&vfs.root()}};
+
+			while (!tree.empty()) {
+				auto* node = tree.top();
+				tree.pop();
+
+				if (auto* child = node->child(name); child != nullptr) return child;
+
+				for (auto const& x : node->children()) {
+					if (x.type() == zenkit::VfsNodeType::FILE) continue;
+					tree.push(&x);
+				}
+			}
+
+			return nullptr;
+		};
+
+		auto vdf = zenkit::Vfs {};
+		for (auto path : {"A/X/Y", "A/Z", "B/Y/A", "b/Q/Z", "C/Z/Z/Z", "C"}) {
+			auto& dir = vdf.mkdir(path);
+			for (auto name : {"tex.tga", "Z", "mesh.mrm"}) {
+				if (dir.child(name) != nullptr) continue;
+				dir.create(zenkit::VfsNode::file(name, zenkit::VfsFileDescriptor {DATA, 1, false}));
+			}
+		}
+
+		for (auto name : {"TEX.TGA", "z", "Y", "A", "mesh.mrm ", "q", "missing", ""}) {
+			CHECK_EQ(vdf.find(name), reference_find(vdf, name));
+
+			auto all = vdf.find_all(name);
+			CHECK_EQ(all.empty() ? nullptr : all.front(), vdf.find(name));
+		}
+
+		CHECK_EQ(vdf.find_all("tex.tga").size(), 6);
+		CHECK_EQ(vdf.find_all("missing").size(), 0);
+
+		vdf.remove("C");
+		CHECK_EQ(vdf.find("tex.tga"), reference_find(vdf, "tex.tga"));
+		CHECK_EQ(vdf.find_all("tex.tga").size(), 4);
+	}
 }
@@ -1,8 +1,10 @@
 // Copyright © 2021-2024 GothicKit Contributors.
 // SPDX-License-Identifier: MIT
 #include <doctest/doctest.h>
+#include <zenkit/Archive.hh>
 #include <zenkit/Material.hh>
 #include <zenkit/World.hh>
+#include <zenkit/vobs/Misc.hh>
 #include <zenkit/vobs/VirtualObject.hh>
 
 #include <zenkit/Stream.hh>
@@ -325,6 +327,163 @@ TEST_SUITE("World") {
 		CHECK_EQ(wp100.direction, zenkit::Vec3 {-0.342115372, 0, 0.939657927});
 	}
 
+	TEST_CASE("World.load(options)") {
+		std::vector<std::byte> buf;
+
+		{
+			auto root = std::make_shared<zenkit::VirtualObject>();
+			root->vob_name = "ROOT";
+
+			auto item = std::make_shared<zenkit::VItem>();
+			item->vob_name = "ITEM0";
+			item->instance = "ITFO_APPLE";
+			root->children.push_back(item);
+
+			auto child = std::make_shared<zenkit::VirtualObject>();
+			child->vob_name = "CHILD";
+			root->children.push_back(child);
+
+			item = std::make_shared<zenkit::VItem>();
+			item->vob_name = "ITEM1";
+			child->children.push_back(item);
+
+			zenkit::World world {};
+			world.world_vobs.push_back(root);
+			world.way_net = std::make_shared<zenkit::WayNet>();
+
+			auto w = zenkit::Write::to(&buf);
+			auto ar = zenkit::WriteArchive::to(w.get(), zenkit::ArchiveFormat::BINSAFE);
+			ar->write_object("%", &world, zenkit::GameVersion::GOTHIC_1);
+			ar->write_header();
+		}
+
+		zenkit::WorldLoadOptions options {};
+		options.mesh = false;
+		options.way_net = false;
+		options.vob_filter = [](zenkit::ArchiveObject const&, zenkit::ObjectType type) {
+			return type == zenkit::ObjectType::oCItem ? zenkit::VobFilterAction::LOAD : zenkit::VobFilterAction::SKIP;
+		};
+
+		auto in = zenkit::Read::from(&buf);
+		zenkit::World world {};
+		world.load(in.get(), zenkit::GameVersion::GOTHIC_1, options);
+
+		// Items are loaded and the VObs around them are not.
+		CHECK_EQ(world.way_net, nullptr);
+		REQUIRE_EQ(world.world_vobs.size(), 2);
+		CHECK_EQ(world.world_vobs[0]->vob_name, "ITEM0");
+		CHECK_EQ(world.world_vobs[1]->vob_name, "ITEM1");
+		CHECK_EQ(world.world_vobs[0]->get_object_type(), zenkit::ObjectType::oCItem);
+		CHECK_EQ(reinterpret_cast<zenkit::VItem&>(*world.world_vobs[0]).instance, "ITFO_APPLE");
+
+		// Skipping a tree skips all of its children.
+		options.mesh = true;
+		options.way_net = true;
+		options.vob_filter = [](zenkit::ArchiveObject const&, zenkit::ObjectType type) {
+			return type == zenkit::ObjectType::zCVob ? zenkit::VobFilterAction::SKIP_TREE
+			                                         : zenkit::VobFilterAction::LOAD;
+		};
+
+		in = zenkit::Read::from(&buf);
+		world = {};
+		world.load(in.get(), zenkit::GameVersion::GOTHIC_1, options);
+
+		CHECK_NE(world.way_net, nullptr);
+		CHECK(world.world_vobs.empty());
+	}
+
+	TEST_CASE("World.save(read_event)") {
+		// Read the mesh of a world using ReadArchive::read_event.
+		auto read_mesh = [](std::vector<std::byte> const& buf) {
+			auto in = zenkit::Read::from(&buf);
+			auto reader = zenkit::ReadArchive::from(in.get());
+
+			zenkit::ArchiveEvent ev;
+			while (reader->read_event(ev)) {
+				if (ev.type != zenkit::ArchiveEventType::OBJECT_BEGIN || ev.object.object_name != "MeshAndBsp") continue;
+				REQUIRE(reader->read_event(ev));
+
+				std::vector<std::byte> mesh(ev.size);
+				in->read(mesh.data(), mesh.size());
+				return mesh;
+			}
+
+			return std::vector<std::byte> {};
+		};
+
+		for (auto format : {zenkit::ArchiveFormat::ASCII, zenkit::ArchiveFormat::BINSAFE}) {
+			std::vector<std::byte> buf;
+
+			{
+				auto vob = std::make_shared<zenkit::VirtualObject>();
+				vob->vob_name = "VOB";
+
+				zenkit::World world {};
+				world.world_vobs.push_back(vob);
+				world.way_net = std::make_shared<zenkit::WayNet>();
+
+				auto w = zenkit::Write::to(&buf);
+				auto ar = zenkit::WriteArchive::to(w.get(), format);
+				ar->write_object("%", &world, zenkit::GameVersion::GOTHIC_1);
+				ar->write_header();
+			}
+
+			auto in = zenkit::Read::from(&buf);
+			auto reader = zenkit::ReadArchive::from(in.get());
+
+			// The mesh follows the `MeshAndBsp` object header as one unnamed raw entry.
+			zenkit::ArchiveEvent ev;
+			size_t depth = 0;
+			size_t meshes = 0;
+
+			while (reader->read_event(ev)) {
+				if (ev.type == zenkit::ArchiveEventType::OBJECT_BEGIN) {
+					++depth;
+
+					if (ev.object.object_name == "MeshAndBsp") {
+						auto mark = in->tell();
+						(void) in->read_uint();
+						auto size = in->read_uint();
+						in->seek(static_cast<ssize_t>(mark), zenkit::Whence::BEG);
+
+						REQUIRE(reader->read_event(ev));
+						CHECK_EQ(ev.type, zenkit::ArchiveEventType::ENTRY);
+						CHECK_EQ(ev.entry, zenkit::ArchiveEntryType::RAW);
+						CHECK(ev.name.empty());
+						CHECK_EQ(ev.size, 8 + size_t {size});
+						++meshes;
+					}
+				} else if (ev.type == zenkit::ArchiveEventType::OBJECT_END) {
+					REQUIRE_NE(depth, 0);
+					--depth;
+				}
+			}
+
+			CHECK_EQ(depth, 0);
+			CHECK_EQ(meshes, 1);
+
+			// Transcoding copies the mesh as well.
+			std::vector<std::byte> out;
+			in = zenkit::Read::from(&buf);
+			reader = zenkit::ReadArchive::from(in.get());
+			reader->transcode(zenkit::Write::to(&out).get(),
+			                  format == zenkit::ArchiveFormat::ASCII ? zenkit::ArchiveFormat::BINSAFE
+			                                                         : zenkit::ArchiveFormat::ASCII);
+
+			CHECK_EQ(read_mesh(out), read_mesh(buf));
+			CHECK_GT(read_mesh(out).size(), 8);
+
+			zenkit::WorldLoadOptions options {};
+			options.mesh = false;
+
+			in = zenkit::Read::from(&out);
+			zenkit::World world {};
+			world.load(in.get(), zenkit::GameVersion::GOTHIC_1, options);
+			REQUIRE_EQ(world.world_vobs.size(), 1);
+			CHECK_EQ(world.world_vobs[0]->vob_name, "VOB");
+		}
+	}
+
 	TEST_CASE("World.load(GOTHIC2)" * doctest::skip()) {
 		// TODO: Stub
 	}